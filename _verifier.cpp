@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <string>
 #include <vector>
 
 struct point {
@@ -38,7 +39,15 @@ int main( ) try {
 
    double cost;
    std::cin >> cost;
-   std::cout << (std::count(covered.begin( ), covered.end( ), true) == covered.size( ) && std::abs(total - cost) < 1e-3) << "\n";
+   bool valid = (std::count(covered.begin( ), covered.end( ), true) == covered.size( ) && std::abs(total - cost) < 1e-3);
+
+   // anytime solvers stopped early append "incomplete <lower bound> <remaining bads>"
+   std::string tag;
+   if (std::cin >> tag) {
+      double bound; int remaining;
+      valid = valid && tag == "incomplete" && std::cin >> bound >> remaining && bound <= cost + 1e-3 && remaining > 0;
+   }
+   std::cout << valid << "\n";
 } catch (...) {
    std::cout << 0 << "\n";
 }
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
+   return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   int closest(const point& p, const std::vector<point>& points) const {
+      int best = -1; double d = std::numeric_limits<double>::max( );
+      for (int r = 0; r <= std::max(w, h) && (best == -1 || d > (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            if (double current = distance(p, points[v]); current < d) {
+               d = current, best = v;
+            }
+         });
+      }
+      return best;
+   }
+   template<typename F> void within(const point& p, double radius, F visit) const {
+      for (int r = 0; r <= std::max(w, h) && (r - 1) * size <= radius; ++r) {
+         ring(p, r, visit);
+      }
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   // argv[1] is the target epsilon: the run stops once its cover is certified within 1 + epsilon of the optimum
+   double epsilon = (argc > 1 ? std::stod(argv[1]) : 0.01);
+   if (!(epsilon > 0)) {
+      throw std::invalid_argument("epsilon must be positive");
+   }
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      std::cin >> points[v].x >> points[v].y;
+   }
+
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<int> closest_v(a + b);
+   std::vector<double> nearest(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      closest_v[v] = (v < a ? grid_b : grid_a).closest(points[v], points);
+      nearest[v] = distance(points[v], points[closest_v[v]]);
+   }
+
+   // the edges of positive reduced cost, each found once by the end with the larger nearest distance, as it is shorter
+   // than twice that distance
+   std::vector<std::vector<std::pair<int, double>>> edges(a + b);
+   double top = 0;
+   for (int v = 0; v < a + b; ++v) {
+      (v < a ? grid_b : grid_a).within(points[v], 2 * nearest[v], [&](int u) {
+         if (double cost = reduced_cost(v, u, points, nearest); cost > 1e-15 && (nearest[v] > nearest[u] || (nearest[v] == nearest[u] && v >= a))) {
+            edges[u].emplace_back(v, cost), edges[v].emplace_back(u, cost);
+            top = std::max(top, cost);
+         }
+      });
+   }
+
+   // the matching becomes a perfect assignment that an auction can solve: a point j of B bids for the points of A it has an
+   // edge to, worth their reduced cost, or for its own dummy object (id j) worth 0; a point i of A has a dummy bidder (id i)
+   // that takes i itself, or the dummy object of a j that took i, both worth 0. Objects and bidders thus share the ids
+   // 0 to a + b - 1, and any prices certify sum(prices) + sum(best profits) >= the maximum matching weight
+   auto options = [&](int u, auto visit) {
+      visit(u, 0.0);
+      for (auto [v, cost] : edges[u]) {
+         visit(v, (u < a ? 0.0 : cost));
+      }
+   };
+   auto profit = [&](int u, const std::vector<double>& price) {
+      double best = std::numeric_limits<double>::lowest( );
+      options(u, [&](int o, double value) {
+         best = std::max(best, value - price[o]);
+      });
+      return best;
+   };
+
+   // epsilon-scaling: every phase restarts the assignment from the prices of the previous one with a quarter of its delta,
+   // and ends with every bidder within delta of its best profit
+   std::vector<double> price(a + b, 0);
+   std::vector<int> owner(a + b), matching(a + b);
+   auto cover = [&](double& total) {
+      std::vector<std::pair<int, int>> used;
+      std::vector<bool> covered(a + b, false);
+      total = 0;
+      for (int i = 0; i < a + b; ++i) {
+         if (!covered[i]) {
+            int matched = (i < a && matching[i] != -1 ? matching[i] : closest_v[i]);
+            used.emplace_back(i, matched);
+            covered[i] = covered[matched] = true;
+            total += distance(points[i], points[matched]);
+         }
+      }
+      return used;
+   };
+   std::vector<std::pair<int, int>> used;
+   double total, ratio;
+   for (double delta = top / 4; ; delta /= 4) {
+      std::fill(owner.begin( ), owner.end( ), -1);
+      std::deque<int> unassigned;
+      for (int u = 0; u < a + b; ++u) {
+         unassigned.push_back(u);
+      }
+      while (!unassigned.empty( )) {
+         int u = unassigned.front( );
+         unassigned.pop_front( );
+         double first = std::numeric_limits<double>::lowest( ), second = first; int best = u;
+         options(u, [&](int o, double value) {
+            if (value - price[o] > first) {
+               second = first, first = value - price[o], best = o;
+            } else {
+               second = std::max(second, value - price[o]);
+            }
+         });
+         price[best] += (second == std::numeric_limits<double>::lowest( ) ? 0 : first - second) + delta;
+         if (owner[best] != -1) {
+            unassigned.push_back(owner[best]);
+         }
+         owner[best] = u;
+      }
+
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v] - price[v] - profit(v, price);
+         matching[v] = -1;
+      }
+      for (int i = 0; i < a; ++i) {
+         if (owner[i] >= a) {
+            matching[i] = owner[i], matching[owner[i]] = i;
+         }
+      }
+      used = cover(total);
+      ratio = (bound > 0 ? total / bound : std::numeric_limits<double>::infinity( ));      // a bound of zero or less certifies nothing
+      std::cerr << "delta " << delta << ": cost " << std::setprecision(9) << std::fixed << total << ", lower bound " << bound << ", ratio " << ratio << "\n" << std::defaultfloat;
+      if (ratio <= 1 + epsilon || delta < top * 1e-12) {
+         break;
+      }
+   }
+   if (ratio <= 1 + epsilon) {
+      std::cerr << "certified ratio " << std::setprecision(9) << std::fixed << ratio << "\n";
+   } else {
+      std::cerr << "uncertified, ratio " << std::setprecision(9) << std::fixed << ratio << " at the smallest delta\n";
+   }
+
+   std::cout << used.size( ) << "\n";
+   for (auto [p1, p2] : used) {
+      std::cout << p1 << " " << p2 << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
+   return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   int closest(const point& p, const std::vector<point>& points) const {
+      int best = -1; double d = std::numeric_limits<double>::max( );
+      for (int r = 0; r <= std::max(w, h) && (best == -1 || d > (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            if (double current = distance(p, points[v]); current < d) {
+               d = current, best = v;
+            }
+         });
+      }
+      return best;
+   }
+   template<typename F> void within(const point& p, double radius, F visit) const {
+      for (int r = 0; r <= std::max(w, h) && (r - 1) * size <= radius; ++r) {
+         ring(p, r, visit);
+      }
+   }
+};
+
+struct disjoint_sets {
+   std::vector<int> parent;
+
+   disjoint_sets(int n)
+   : parent(n) {
+      std::iota(parent.begin( ), parent.end( ), 0);
+   }
+   int find(int v) {
+      for (; parent[v] != v; v = parent[v]) {
+         parent[v] = parent[parent[v]];
+      }
+      return v;
+   }
+   void unite(int u, int v) {
+      parent[find(u)] = find(v);
+   }
+};
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
+      if (matching[j] == -1 && beta[j] > 1e-15) {
+         queue.emplace(key[j] = beta[j], j);
+      }
+   }
+   int top( ) const {
+      return (queue.empty( ) ? -1 : queue.begin( )->second);
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1)
+   std::vector<int> members, position;
+   int first;
+
+   vertex_set(int n, int f = 0)
+   : position(n, -1), first(f) {
+   }
+   void insert(int v) {
+      if (position[v - first] == -1) {
+         position[v - first] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = position[v - first]; p != -1) {
+         position[members.back( ) - first] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v - first] = -1;
+      }
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v - first] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+};
+
+void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
+   thread_local std::vector<std::pair<int, int>> path;      // scratch reused by every phase of a worker
+   path.clear( );
+   for (int p = start; tree[p] != -1; p = tree[p]) {
+      path.emplace_back(p, tree[p]);
+   }
+   for (int c = 1 - path.size( ) % 2; c < path.size( ); c += 2) {
+      for (int p : { path[c].first, path[c].second }) {
+         if (matching[p] != -1) {
+            matching[matching[p]] = -1;
+         }
+      }
+      matching[path[c].first] = path[c].second;
+      matching[path[c].second] = path[c].first;
+   }
+}
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+int solve(std::vector<int> ids, int a, const std::vector<point>& points, const std::vector<double>& nearest,
+          std::vector<int>& matching, std::vector<double>& dual, const deadline& limit) {
+   // Hungarian phases from single bads on a local copy of one component, ids[0, a) being one side; like orient, the smaller
+   // side becomes B. Only the entries of ids are written back, so components are solved concurrently
+   int b = ids.size( ) - a;
+   if (a < b) {
+      std::rotate(ids.begin( ), ids.begin( ) + a, ids.end( ));
+      std::swap(a, b);
+   }
+   std::vector<point> local(a + b);
+   std::vector<double> near(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      local[v] = points[ids[v]], near[v] = nearest[ids[v]];
+   }
+
+   std::vector<int> mate(a + b, -1);
+   std::vector<double> alpha(a, 0);
+   std::vector<double> beta(a + b, 0);
+   for (int j = a; j < a + b; ++j) {
+      for (int i = 0; i < a; ++i) {
+         beta[j] = std::max(beta[j], reduced_cost(i, j, local, near));
+      }
+   }
+
+   vertex_set f(a), s(a + b), t(a);
+   for (int i = 0; i < a; ++i) {
+      f.insert(i);
+   }
+   std::vector<int> tree(a + b, -1);
+
+   bad_queue bads(a, b, mate, beta);
+   for (int rj; !limit.expired( ) && (rj = bads.top( )) != -1; s.clear( ), t.clear( )) {
+      int ej = rj; double epsilon = beta[ej];
+      s.insert(rj);
+
+      for (;;) {
+         if (limit.expired( )) {
+            // the tree alive at the deadline is dropped as it stands, its duals are feasible already
+            break;
+         }
+
+         double delta = std::numeric_limits<double>::max( ); int di, dj;
+         for (int i : f) {
+            for (int j : s) {
+               if (double check = alpha[i] + beta[j] - reduced_cost(i, j, local, near); check < delta) {
+                  delta = check, di = i, dj = j;
+               }
+            }
+         }
+
+         // case 1, a slack rounded below zero counts as tight
+         if (delta <= 1e-15 && mate[di] == -1) {
+            tree[di] = dj;
+            update_matching(mate, tree, di, a, b);
+            break;
+         }
+
+         // case 2
+         if (delta <= 1e-15 && mate[di] != -1) {
+            int kj = mate[di];
+            tree[kj] = di, tree[di] = dj;
+            f.erase(di), t.insert(di), s.insert(kj);
+            if (beta[kj] < epsilon) {
+               epsilon = beta[kj], ej = kj;
+            }
+            continue;
+         }
+
+         // case 3
+         if (epsilon > delta) {
+            for (int i : t) {
+               alpha[i] += delta;
+            }
+            for (int j : s) {
+               beta[j] -= delta;
+            }
+            epsilon -= delta;
+            continue;
+         }
+
+         // case 4
+         if (delta >= epsilon) {
+            for (int i : t) {
+               alpha[i] += epsilon;
+            }
+            for (int j : s) {
+               beta[j] -= epsilon;
+            }
+            epsilon -= epsilon;
+            update_matching(mate, tree, ej, a, b);
+            break;
+         }
+      }
+
+      for (int i : t) {
+         f.insert(i);
+      }
+      for (int j : s) {
+         tree[j] = -1;
+         bads.update(j, mate, beta);
+      }
+   }
+
+   for (int v = 0; v < a + b; ++v) {
+      matching[ids[v]] = (mate[v] == -1 ? -1 : ids[mate[v]]);
+      dual[ids[v]] = (v < a ? alpha[v] : beta[v]);
+   }
+   return bads.queue.size( );
+}
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+   int threads = (argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency( )));
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      std::cin >> points[v].x >> points[v].y;
+   }
+
+   // nearest neighbours through one grid per side instead of all a * b distances
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<int> closest_v(a + b);
+   std::vector<double> nearest(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      closest_v[v] = (v < a ? grid_b : grid_a).closest(points[v], points);
+      nearest[v] = distance(points[v], points[closest_v[v]]);
+   }
+
+   // only edges of positive reduced cost can enter the matching, and such an edge is shorter than twice the nearest
+   // distance of one of its ends, so every point searches the other side within twice its own nearest distance;
+   // a point also joins the component of its closest point, so a component sees the same nearest distances on its own;
+   // that edge has reduced cost nearest[closest_v[v]], so every component holds a positive edge and is solved
+   disjoint_sets components(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      components.unite(v, closest_v[v]);
+      (v < a ? grid_b : grid_a).within(points[v], 2 * nearest[v], [&](int u) {
+         if (reduced_cost(v, u, points, nearest) > 1e-15) {
+            components.unite(v, u);
+         }
+      });
+   }
+
+   std::vector<std::vector<int>> members(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      members[components.find(v)].push_back(v);      // A before B, as v increases
+   }
+   std::vector<int> order;
+   for (int r = 0; r < a + b; ++r) {
+      if (!members[r].empty( )) {
+         order.push_back(r);
+      }
+   }
+   std::sort(order.begin( ), order.end( ), [&](int r1, int r2) {
+      return members[r1].size( ) > members[r2].size( );
+   });
+
+   // largest components first, each worker takes the next unsolved one
+   std::vector<int> matching(a + b, -1);
+   std::vector<double> dual(a + b, 0);
+   std::atomic<int> next = 0, remaining = 0;
+   std::vector<std::thread> workers;
+   for (int w = 0; w < threads; ++w) {
+      workers.emplace_back([&] {
+         for (int c; (c = next++) < order.size( );) {
+            const auto& ids = members[order[c]];
+            int in_a = std::partition_point(ids.begin( ), ids.end( ), [&](int v) {
+               return v < a;
+            }) - ids.begin( );
+            remaining += solve(ids, in_a, points, nearest, matching, dual, limit);
+         }
+      });
+   }
+   for (auto& worker : workers) {
+      worker.join( );
+   }
+   std::cerr << order.size( ) << " components, largest " << (order.empty( ) ? 0 : members[order[0]].size( )) << " points\n";
+
+   std::vector<std::pair<int, int>> used;
+   std::vector<bool> covered(a + b, false);
+   double total = 0;
+   for (int i = 0; i < a + b; ++i) {
+      if (!covered[i]) {
+         int matched = (i < a && matching[i] != -1 ? matching[i] : closest_v[i]);
+         used.emplace_back(i, matched);
+         covered[i] = covered[matched] = true;
+         total += distance(points[i], points[matched]);
+      }
+   }
+
+   std::cout << used.size( ) << "\n";
+   for (auto [p1, p2] : used) {
+      std::cout << p1 << " " << p2 << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (remaining > 0) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v] - dual[v];
+      }
+      std::cout << "incomplete " << bound << " " << remaining << "\n";
+   }
+} catch (...) {
+   return -1;
+}
@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
+   return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      key.resize(std::max<int>(key.size( ), j + 1), 0);
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
+      if (matching[j] == -1 && beta[j] > 1e-15) {
+         queue.emplace(key[j] = beta[j], j);
+      }
+   }
+   void erase(int j) {
+      if (j < key.size( )) {
+         queue.erase({ key[j], j });
+      }
+   }
+   int top( ) const {
+      return (queue.empty( ) ? -1 : queue.begin( )->second);
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1);
+   // the positions grow with the ids handed out to inserted points
+   std::vector<int> members, position;
+
+   void insert(int v) {
+      if (v >= position.size( )) {
+         position.resize(v + 1, -1);
+      }
+      if (position[v] == -1) {
+         position[v] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = (v < position.size( ) ? position[v] : -1); p != -1) {
+         position[members.back( )] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v] = -1;
+      }
+   }
+   bool contains(int v) const {
+      return v < position.size( ) && position[v] != -1;
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+   int size( ) const {
+      return members.size( );
+   }
+   bool empty( ) const {
+      return members.empty( );
+   }
+};
+
+void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start) {
+   static std::vector<std::pair<int, int>> path;      // scratch reused by every phase
+   path.clear( );
+   for (int p = start; tree[p] != -1; p = tree[p]) {
+      path.emplace_back(p, tree[p]);
+   }
+   for (int c = 1 - path.size( ) % 2; c < path.size( ); c += 2) {
+      for (int p : { path[c].first, path[c].second }) {
+         if (matching[p] != -1) {
+            matching[matching[p]] = -1;
+         }
+      }
+      matching[path[c].first] = path[c].second;
+      matching[path[c].second] = path[c].first;
+   }
+}
+
+struct dynamic_cover {
+   // an optimal cover kept up to date under insertions and deletions: an update moves the nearest distances around it,
+   // the vertices whose reduced costs changed leave the matching and get their duals recomputed, and only the bads this
+   // creates are run through Hungarian phases; ids are handed out in insertion order and never reused
+   std::vector<point> points;
+   std::vector<bool> side_a;
+   std::vector<int> matching, closest_v, tree;
+   std::vector<double> nearest, alpha, beta;
+   vertex_set f, bs, s, t, touched;    // between phases f holds the live points of A, bs always holds those of B
+   bad_queue bads;
+
+   int insert(const point& p, bool in_a) {
+      int v = points.size( );
+      points.push_back(p), side_a.push_back(in_a);
+      matching.push_back(-1), closest_v.push_back(-1), tree.push_back(-1);
+      nearest.push_back(std::numeric_limits<double>::max( )), alpha.push_back(0), beta.push_back(0);
+      for (int u : (in_a ? bs : f)) {
+         double d = distance(points[u], p);
+         if (d < nearest[v]) {
+            nearest[v] = d, closest_v[v] = u;
+         }
+         if (d < nearest[u]) {
+            nearest[u] = d, closest_v[u] = v;
+            touch(u);
+         }
+      }
+      (in_a ? f : bs).insert(v), touch(v);
+      return v;
+   }
+   void erase(int v) {
+      if (v < 0 || v >= points.size( ) || !(side_a[v] ? f : bs).contains(v)) {
+         throw std::invalid_argument("no such point");
+      }
+      touch(v);
+      (side_a[v] ? f : bs).erase(v), touched.erase(v), bads.erase(v);
+      for (int u : (side_a[v] ? bs : f)) {
+         if (closest_v[u] == v) {
+            nearest[u] = std::numeric_limits<double>::max( ), closest_v[u] = -1;
+            for (int w : (side_a[v] ? f : bs)) {
+               if (double d = distance(points[u], points[w]); d < nearest[u]) {
+                  nearest[u] = d, closest_v[u] = w;
+               }
+            }
+            touch(u);
+         }
+      }
+   }
+   void touch(int v) {
+      // the reduced costs of v changed or its mate left: v is unmatched and its dual recomputed by repair
+      if (int mate = matching[v]; mate != -1) {
+         matching[v] = matching[mate] = -1;
+         touched.insert(mate);
+      }
+      touched.insert(v);
+   }
+   void repair( ) {
+      // restores dual feasibility, tight matched edges and zero alpha on unmatched A; an A vertex restarts at alpha = 0
+      // and raises the betas it violates, a B vertex takes the smallest feasible beta
+      while (!touched.empty( )) {
+         int v = touched.members.back( );
+         touched.erase(v);
+         if (side_a[v]) {
+            alpha[v] = 0;
+            for (int j : bs) {
+               if (double need = reduced_cost(v, j, points, nearest); need > beta[j]) {
+                  if (matching[j] != -1 && need > beta[j] + 1e-12) {
+                     touch(j);
+                  } else {
+                     beta[j] = need;
+                     bads.update(j, matching, beta);
+                  }
+               }
+            }
+         } else {
+            beta[v] = 0;
+            for (int i : f) {
+               beta[v] = std::max(beta[v], reduced_cost(i, v, points, nearest) - alpha[i]);
+            }
+            bads.update(v, matching, beta);
+         }
+      }
+   }
+   int reoptimize( ) {
+      if (f.empty( ) || bs.empty( )) {
+         throw std::invalid_argument("both sides need a point");
+      }
+      repair( );
+
+      int phases = 0;
+      for (int rj; (rj = bads.top( )) != -1; s.clear( ), t.clear( ), ++phases) {
+         int ej = rj; double epsilon = beta[ej];
+         s.insert(rj);
+
+         for (;;) {
+            double delta = std::numeric_limits<double>::max( ); int di, dj;
+            for (int i : f) {
+               for (int j : s) {
+                  if (double check = alpha[i] + beta[j] - reduced_cost(i, j, points, nearest); check < delta) {
+                     delta = check, di = i, dj = j;
+                  }
+               }
+            }
+
+            // case 1, a slack rounded below zero counts as tight: the duals of repaired vertices are off by an ulp more often
+            // than those of a fresh solve, and a negative delta would otherwise be applied as a dual change forever
+            if (delta <= 1e-15 && matching[di] == -1) {
+               tree[di] = dj;
+               update_matching(matching, tree, di);
+               break;
+            }
+
+            // case 2
+            if (delta <= 1e-15 && matching[di] != -1) {
+               int kj = matching[di];
+               tree[kj] = di, tree[di] = dj;
+               f.erase(di), t.insert(di), s.insert(kj);
+               if (beta[kj] < epsilon) {
+                  epsilon = beta[kj], ej = kj;
+               }
+               continue;
+            }
+
+            // case 3
+            if (epsilon > delta) {
+               for (int i : t) {
+                  alpha[i] += delta;
+               }
+               for (int j : s) {
+                  beta[j] -= delta;
+               }
+               epsilon -= delta;
+               continue;
+            }
+
+            // case 4
+            if (delta >= epsilon) {
+               for (int i : t) {
+                  alpha[i] += epsilon;
+               }
+               for (int j : s) {
+                  beta[j] -= epsilon;
+               }
+               epsilon -= epsilon;
+               update_matching(matching, tree, ej);
+               break;
+            }
+         }
+
+         for (int i : t) {
+            f.insert(i);
+         }
+         for (int j : s) {
+            tree[j] = -1;
+            bads.update(j, matching, beta);
+         }
+      }
+      return phases;
+   }
+   std::vector<std::pair<int, int>> cover(double& total) const {
+      std::vector<std::pair<int, int>> used;
+      std::vector<bool> covered(points.size( ), false);
+      total = 0;
+      for (auto side : { &f, &bs }) {
+         for (int v : *side) {
+            if (!covered[v]) {
+               int matched = (matching[v] != -1 ? matching[v] : closest_v[v]);
+               used.emplace_back(v, matched);
+               covered[v] = covered[matched] = true;
+               total += distance(points[v], points[matched]);
+            }
+         }
+      }
+      return used;
+   }
+};
+
+int main( ) try {
+   // the instance may be followed by update batches: a count, then that many lines "+ A x y", "+ B x y" or "- id", where the
+   // points of the instance have ids 0 to a + b - 1 and inserted points continue the numbering; every batch is reported on
+   // stderr, and the final cover is printed as usual over the surviving points, those of A first, both sides in id order
+   auto start = std::chrono::steady_clock::now( );
+   dynamic_cover dynamic;
+   int a, b;
+   std::cin >> a >> b;
+   for (int v = 0; v < a + b; ++v) {
+      point p;
+      std::cin >> p.x >> p.y;
+      dynamic.insert(p, v < a);
+   }
+
+   auto reoptimize = [&](int batch, int updates, std::chrono::steady_clock::time_point start) {
+      int phases = dynamic.reoptimize( );
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+      double total;
+      dynamic.cover(total);
+      std::cerr << "batch " << batch << ": " << updates << " updates, " << phases << " phases, cost " << std::setprecision(9) << std::fixed << total << ", " << elapsed.count( ) << " s\n";
+   };
+   reoptimize(0, a + b, start);
+   for (int batch = 1, k; std::cin >> k; ++batch) {
+      start = std::chrono::steady_clock::now( );
+      for (int c = 0; c < k; ++c) {
+         char op;
+         std::cin >> op;
+         if (op == '+') {
+            char side; point p;
+            std::cin >> side >> p.x >> p.y;
+            dynamic.insert(p, side == 'A');
+         } else {
+            int v;
+            std::cin >> v;
+            dynamic.erase(v);
+         }
+      }
+      reoptimize(batch, k, start);
+   }
+
+   std::vector<int> index(dynamic.points.size( ), -1);
+   int n = 0;
+   for (auto side : { &dynamic.f, &dynamic.bs }) {
+      for (int v : std::set<int>(side->begin( ), side->end( ))) {
+         index[v] = n++;
+      }
+   }
+   double total;
+   auto used = dynamic.cover(total);
+   std::cout << used.size( ) << "\n";
+   for (auto [p1, p2] : used) {
+      std::cout << index[p1] << " " << index[p2] << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
@@ -1,12 +1,15 @@
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <csignal>
 #include <deque>
 #include <exception>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -27,17 +30,97 @@ double reduced_cost(int p1, int p2, const std::vector<point>& points, const std:
    return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
 }
 
-int find_bad(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta) {
-   for (int j = a; j < a + b; ++j) {
+bool orient(int& a, int& b, std::vector<point>& points) {
+   // every phase grows a tree from a bad of B, and nearly every point starts bad: the edge from v to its nearest point u has
+   // reduced cost nearest[u], zero only when u coincides with a point of the other side; so B should be the smaller side
+   if (a < b) {
+      std::rotate(points.begin( ), points.begin( ) + a, points.end( ));
+      std::swap(a, b);
+      return true;
+   }
+   return false;
+}
+
+int original(int v, int a, int b, bool swapped) {
+   // after a swap the first a points are the original B
+   return (!swapped ? v : v < a ? v + b : v - a);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
       if (matching[j] == -1 && beta[j] > 1e-15) {
-         return j;
+         queue.emplace(key[j] = beta[j], j);
       }
    }
-   return -1;
-}
+   int top( ) const {
+      return (queue.empty( ) ? -1 : queue.begin( )->second);
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1)
+   std::vector<int> members, position;
+   int first;
+
+   vertex_set(int n, int f = 0)
+   : position(n, -1), first(f) {
+   }
+   void insert(int v) {
+      if (position[v - first] == -1) {
+         position[v - first] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = position[v - first]; p != -1) {
+         position[members.back( ) - first] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v - first] = -1;
+      }
+   }
+   bool contains(int v) const {
+      return position[v - first] != -1;
+   }
+   void merge(vertex_set& other) {
+      for (int v : other.members) {
+         insert(v);
+      }
+      other.clear( );
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v - first] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+   int size( ) const {
+      return members.size( );
+   }
+   bool empty( ) const {
+      return members.empty( );
+   }
+};
 
 void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
-   std::vector<std::pair<int, int>> path;
+   static std::vector<std::pair<int, int>> path;      // scratch reused by every phase
+   path.clear( );
    for (int p = start; tree[p] != -1; p = tree[p]) {
       path.emplace_back(p, tree[p]);
    }
@@ -52,7 +135,32 @@ void update_matching(std::vector<int>& matching, std::vector<int>& tree, int sta
    }
 }
 
-int main( ) try {
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+
    int a, b;
    std::cin >> a >> b;
 
@@ -60,6 +168,7 @@ int main( ) try {
    for (int v = 0; v < a + b; ++v) {
       std::cin >> points[v].x >> points[v].y;
    }
+   bool swapped = orient(a, b, points);
 
    std::vector<int> closest_v(a + b);
    std::vector<double> nearest(a + b, std::numeric_limits<double>::max( ));
@@ -86,15 +195,24 @@ int main( ) try {
       }
    }
 
-   for (int rj; (rj = find_bad(a, b, matching, beta)) != -1;) {
+   // f, s, t and tree outlive the phases, only the vertices a phase touched are restored at its end
+   vertex_set f(a), s(a + b), t(a);
+   for (int i = 0; i < a; ++i) {
+      f.insert(i);
+   }
+   std::vector<int> tree(a + b, -1);
+
+   bad_queue bads(a, b, matching, beta);
+   for (int rj; !limit.expired( ) && (rj = bads.top( )) != -1; s.clear( ), t.clear( )) {
       int ej = rj; double epsilon = beta[ej];
-      std::set<int> s = { rj }, t, f;
-      for (int i = 0; i < a; ++i) {
-         f.insert(i);
-      }
-      std::vector<int> tree(a + b, -1);
+      s.insert(rj);
 
       for (;;) {
+         if (limit.expired( )) {
+            // the tree alive at the deadline is dropped as it stands, its duals are feasible already
+            break;
+         }
+
          double delta = std::numeric_limits<double>::max( ); int di, dj;
          for (int i : f) {
             for (int j : s) {
@@ -104,15 +222,15 @@ int main( ) try {
             }
          }
 
-         // case 1
-         if (std::abs(delta) <= 1e-15 && matching[di] == -1) {
+         // case 1, a slack rounded below zero counts as tight
+         if (delta <= 1e-15 && matching[di] == -1) {
             tree[di] = dj;
             update_matching(matching, tree, di, a, b);
             break;
          }
 
          // case 2
-         if (std::abs(delta) <= 1e-15 && matching[di] != -1) {
+         if (delta <= 1e-15 && matching[di] != -1) {
             int kj = matching[di];
             tree[kj] = di, tree[di] = dj;
             f.erase(di), t.insert(di), s.insert(kj);
@@ -147,6 +265,14 @@ int main( ) try {
             break;
          }
       }
+
+      for (int i : t) {
+         f.insert(i);
+      }
+      for (int j : s) {
+         tree[j] = -1;
+         bads.update(j, matching, beta);
+      }
    }
 
    std::vector<std::pair<int, int>> used;
@@ -163,9 +289,23 @@ int main( ) try {
 
    std::cout << used.size( ) << "\n";
    for (auto [p1, p2] : used) {
-      std::cout << p1 << " " << p2 << "\n";
+      std::cout << original(p1, a, b, swapped) << " " << original(p2, a, b, swapped) << "\n";
    }
    std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (!bads.queue.empty( )) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v];
+      }
+      for (int i = 0; i < a; ++i) {
+         bound -= alpha[i];
+      }
+      for (int j = a; j < a + b; ++j) {
+         bound -= beta[j];
+      }
+      std::cout << "incomplete " << bound << " " << bads.queue.size( ) << "\n";
+   }
 } catch (...) {
    return -1;
 }
@@ -1,12 +1,16 @@
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <csignal>
 #include <deque>
 #include <exception>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <set>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -27,18 +31,143 @@ double reduced_cost(int p1, int p2, const std::vector<point>& points, const std:
    return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
 }
 
-std::set<int> find_bads(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta) {
-   std::set<int> res;
-   for (int j = a; j < a + b; ++j) {
+bool orient(int& a, int& b, std::vector<point>& points) {
+   // every phase grows a tree from a bad of B, and nearly every point starts bad: the edge from v to its nearest point u has
+   // reduced cost nearest[u], zero only when u coincides with a point of the other side; so B should be the smaller side
+   if (a < b) {
+      std::rotate(points.begin( ), points.begin( ) + a, points.end( ));
+      std::swap(a, b);
+      return true;
+   }
+   return false;
+}
+
+int original(int v, int a, int b, bool swapped) {
+   // after a swap the first a points are the original B
+   return (!swapped ? v : v < a ? v + b : v - a);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
       if (matching[j] == -1 && beta[j] > 1e-15) {
-         res.insert(j);
+         queue.emplace(key[j] = beta[j], j);
       }
    }
-   return res;
-}
+};
+
+struct bad_policy {
+   // which bads seed the next phase: all of them, the k largest betas, the next k along a sweep in x,
+   // the largest beta with its k - 1 nearest bads, or the largest betas in a batch that adapts to the phase cost
+   std::string name;
+   int k, phase = 0;
+   double sweep = std::numeric_limits<double>::lowest( ), last = std::numeric_limits<double>::max( );
+
+   bad_policy(int argc, char* argv[])
+   : name(argc > 1 ? argv[1] : "all"), k(argc > 2 ? std::stoi(argv[2]) : 1) {
+      if (name != "all" && name != "beta" && name != "sweep" && name != "cluster" && name != "adaptive" || k < 1) {
+         throw std::invalid_argument("unknown bad policy");
+      }
+   }
+   std::vector<int> next(const bad_queue& bads, const std::vector<point>& points) {
+      // beta and adaptive read only the k largest betas off the queue, sweep and cluster have to look at every bad
+      int take = (name == "beta" || name == "adaptive" ? k : bads.queue.size( ));
+      std::vector<int> all;
+      for (auto it = bads.queue.rbegin( ); it != bads.queue.rend( ) && all.size( ) < take; ++it) {
+         all.push_back(it->second);
+      }
+      if (name == "all" || all.size( ) <= k) {
+         return all;
+      }
+      if (name == "sweep") {
+         std::sort(all.begin( ), all.end( ), [&](int j1, int j2) {
+            return points[j1].x < points[j2].x;
+         });
+         std::rotate(all.begin( ), std::find_if(all.begin( ), all.end( ), [&](int j) {
+            return points[j].x >= sweep;
+         }), all.end( ));
+         sweep = std::nextafter(points[all[k - 1]].x, std::numeric_limits<double>::max( ));
+      } else if (name == "cluster") {
+         std::nth_element(all.begin( ) + 1, all.begin( ) + k - 1, all.end( ), [&](int j1, int j2) {
+            return distance(points[j1], points[all[0]]) < distance(points[j2], points[all[0]]);
+         });
+      }
+      all.resize(k);
+      return all;
+   }
+   void report(int seeded, int tree, double seconds) {
+      std::cerr << "phase " << ++phase << ": " << seeded << " bads, tree size " << tree << ", " << seconds << " s\n";
+      if (name == "adaptive") {
+         // the batch keeps doubling while the time per seeded bad does not get worse
+         k = (seconds / seeded <= last ? 2 * k : std::max(1, k / 2));
+         last = seconds / seeded;
+      }
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1)
+   std::vector<int> members, position;
+   int first;
+
+   vertex_set(int n, int f = 0)
+   : position(n, -1), first(f) {
+   }
+   void insert(int v) {
+      if (position[v - first] == -1) {
+         position[v - first] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = position[v - first]; p != -1) {
+         position[members.back( ) - first] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v - first] = -1;
+      }
+   }
+   bool contains(int v) const {
+      return position[v - first] != -1;
+   }
+   void merge(vertex_set& other) {
+      for (int v : other.members) {
+         insert(v);
+      }
+      other.clear( );
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v - first] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+   int size( ) const {
+      return members.size( );
+   }
+   bool empty( ) const {
+      return members.empty( );
+   }
+};
 
 void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
-   std::vector<std::pair<int, int>> path;
+   static std::vector<std::pair<int, int>> path;      // scratch reused by every phase
+   path.clear( );
    for (int p = start; tree[p] != -1; p = tree[p]) {
       path.emplace_back(p, tree[p]);
    }
@@ -53,7 +182,33 @@ void update_matching(std::vector<int>& matching, std::vector<int>& tree, int sta
    }
 }
 
-int main( ) try {
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+   bad_policy policy(argc, argv);
+
    int a, b;
    std::cin >> a >> b;
 
@@ -61,6 +216,7 @@ int main( ) try {
    for (int v = 0; v < a + b; ++v) {
       std::cin >> points[v].x >> points[v].y;
    }
+   bool swapped = orient(a, b, points);
 
    std::vector<int> closest_v(a + b);
    std::vector<double> nearest(a + b, std::numeric_limits<double>::max( ));
@@ -87,37 +243,99 @@ int main( ) try {
       }
    }
 
-   for (std::set<int> s; !(s = find_bads(a, b, matching, beta)).empty( );) {
+   // the forest outlives the phases, only the vertices of dead trees are restored
+   vertex_set f(a), s(a + b), t(a);
+   for (int i = 0; i < a; ++i) {
+      f.insert(i);
+   }
+   std::vector<int> tree(a + b, -1), root(a + b, -1);
+   std::vector<bool> dead(a + b, false);
+
+   bad_queue bads(a, b, matching, beta);
+   for (std::vector<int> seeds; !limit.expired( ) && !(seeds = policy.next(bads, points)).empty( );) {
+      auto start = std::chrono::steady_clock::now( ); int seeded = seeds.size( );
+      for (int j : seeds) {
+         s.insert(j);
+      }
       int ej = *std::min_element(s.begin( ), s.end( ), [&](int j1, int j2) {
          return beta[j1] < beta[j2];
-      }); double epsilon = beta[ej];
-      std::set<int> t, f;
-      for (int i = 0; i < a; ++i) {
-         f.insert(i);
+      });
+      double epsilon = beta[ej];
+      bool augmented = false; int forest = 0;
+      for (int j : s) {
+         root[j] = j, dead[j] = false;
       }
-      std::vector<int> tree(a + b, -1);
+      auto kill = [&](int r) {
+         dead[r] = true;
+         if (dead[root[ej]]) {
+            epsilon = std::numeric_limits<double>::max( );
+            for (int j : s) {
+               if (double current = beta[j]; !dead[root[j]] && current < epsilon) {
+                  epsilon = current, ej = j;
+               }
+            }
+         }
+      };
+      auto release = [&] {
+         // backwards, so the member swapped into a freed slot has been visited already
+         for (int c = t.size( ) - 1; c >= 0; --c) {
+            if (int i = t.members[c]; dead[root[i]]) {
+               f.insert(i), t.erase(i), forest += 1;
+            }
+         }
+         for (int c = s.size( ) - 1; c >= 0; --c) {
+            if (int j = s.members[c]; dead[root[j]]) {
+               tree[j] = -1, s.erase(j), forest += 1;
+               bads.update(j, matching, beta);
+            }
+         }
+      };
 
       for (;;) {
+         if (limit.expired( )) {
+            // the trees alive at the deadline are released as they stand, their duals are feasible already
+            for (int j : s) {
+               dead[root[j]] = true;
+            }
+            release( );
+            break;
+         }
+
          double delta = std::numeric_limits<double>::max( ); int di, dj;
          for (int i : f) {
             for (int j : s) {
+               if (dead[root[j]]) {
+                  continue;
+               }
                if (double check = alpha[i] + beta[j] - reduced_cost(i, j, points, nearest); check < delta) {
                   delta = check, di = i, dj = j;
                }
             }
          }
 
-         // case 1
-         if (std::abs(delta) <= 1e-15 && matching[di] == -1) {
-            tree[di] = dj;
+         // no tight augmenting path left at the current duals: the dead trees leave the forest, the others keep what they explored
+         if (augmented && std::min(delta, epsilon) > 1e-15) {
+            release( ), augmented = false;
+            if (s.empty( )) {
+               break;
+            }
+            continue;
+         }
+
+         // case 1, a slack rounded below zero counts as tight
+         if (delta <= 1e-15 && matching[di] == -1) {
+            tree[di] = dj, root[di] = root[dj];
+            f.erase(di), t.insert(di);
             update_matching(matching, tree, di, a, b);
-            break;
+            kill(root[dj]), augmented = true;
+            continue;
          }
 
          // case 2
-         if (std::abs(delta) <= 1e-15 && matching[di] != -1) {
+         if (delta <= 1e-15 && matching[di] != -1) {
             int kj = matching[di];
             tree[kj] = di, tree[di] = dj;
+            root[kj] = root[di] = root[dj];
             f.erase(di), t.insert(di), s.insert(kj);
             if (beta[kj] < epsilon) {
                epsilon = beta[kj], ej = kj;
@@ -147,9 +365,13 @@ int main( ) try {
             }
             epsilon -= epsilon;
             update_matching(matching, tree, ej, a, b);
-            break;
+            kill(root[ej]), augmented = true;
+            continue;
          }
       }
+
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+      policy.report(seeded, forest, elapsed.count( ));
    }
 
    std::vector<std::pair<int, int>> used;
@@ -166,9 +388,23 @@ int main( ) try {
 
    std::cout << used.size( ) << "\n";
    for (auto [p1, p2] : used) {
-      std::cout << p1 << " " << p2 << "\n";
+      std::cout << original(p1, a, b, swapped) << " " << original(p2, a, b, swapped) << "\n";
    }
    std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (!bads.queue.empty( )) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v];
+      }
+      for (int i = 0; i < a; ++i) {
+         bound -= alpha[i];
+      }
+      for (int j = a; j < a + b; ++j) {
+         bound -= beta[j];
+      }
+      std::cout << "incomplete " << bound << " " << bads.queue.size( ) << "\n";
+   }
 } catch (...) {
    return -1;
 }
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
+   return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
+}
+
+bool orient(int& a, int& b, std::vector<point>& points) {
+   // every phase grows a tree from a bad of B, and nearly every point starts bad: the edge from v to its nearest point u has
+   // reduced cost nearest[u], zero only when u coincides with a point of the other side; so B should be the smaller side
+   if (a < b) {
+      std::rotate(points.begin( ), points.begin( ) + a, points.end( ));
+      std::swap(a, b);
+      return true;
+   }
+   return false;
+}
+
+int original(int v, int a, int b, bool swapped) {
+   // after a swap the first a points are the original B
+   return (!swapped ? v : v < a ? v + b : v - a);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
+      if (matching[j] == -1 && beta[j] > 1e-15) {
+         queue.emplace(key[j] = beta[j], j);
+      }
+   }
+   std::vector<int> batch(int k, const std::vector<point>& points) const {
+      // k bads evenly spaced along a sweep in x, so their trees are unlikely to meet
+      std::vector<int> res, all;
+      for (auto [beta, j] : queue) {
+         all.push_back(j);
+      }
+      std::sort(all.begin( ), all.end( ), [&](int j1, int j2) {
+         return points[j1].x < points[j2].x;
+      });
+      for (int c = 0; c < std::min<int>(k, all.size( )); ++c) {
+         res.push_back(all[(long long)c * all.size( ) / std::min<int>(k, all.size( ))]);
+      }
+      return res;
+   }
+   bool empty( ) const {
+      return queue.empty( );
+   }
+};
+
+void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
+   std::vector<std::pair<int, int>> path;
+   for (int p = start; tree[p] != -1; p = tree[p]) {
+      path.emplace_back(p, tree[p]);
+   }
+   for (int c = 1 - path.size( ) % 2; c < path.size( ); c += 2) {
+      for (int p : { path[c].first, path[c].second }) {
+         if (matching[p] != -1) {
+            matching[matching[p]] = -1;
+         }
+      }
+      matching[path[c].first] = path[c].second;
+      matching[path[c].second] = path[c].first;
+   }
+}
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+struct growth {
+   std::vector<int> tree;
+   std::vector<std::pair<int, double>> t, s;     // tree vertices and the local offset at which they joined
+   int start;
+   double change = 0;
+};
+
+growth grow(int rj, int a, int b, const std::vector<point>& points, const std::vector<double>& nearest, const std::vector<int>& matching, const std::vector<double>& alpha, const std::vector<double>& beta, const deadline& limit) {
+   growth res{ std::vector<int>(a + b, -1) };
+   std::vector<double> key(a, std::numeric_limits<double>::max( ));
+   std::vector<int> arg(a, -1);
+   std::vector<char> in_t(a, false);
+   auto join = [&](int j, double weight) {
+      for (int i = 0; i < a; ++i) {
+         if (double check = distance(points[i], points[j]) - (nearest[i] - alpha[i]) - weight; !in_t[i] && check < key[i]) {
+            key[i] = check, arg[i] = j;
+         }
+      }
+   };
+
+   int ej = rj; double epsilon = beta[ej], &change = res.change;
+   res.s.emplace_back(rj, 0);
+   join(rj, nearest[rj] - beta[rj]);
+   for (;;) {
+      if (limit.expired( )) {
+         // a tree cut off by the deadline has no start and is discarded with the conflicts of its round
+         res.start = -1;
+         return res;
+      }
+
+      double delta = std::numeric_limits<double>::max( ); int di;
+      for (int i = 0; i < a; ++i) {
+         if (!in_t[i] && key[i] - change < delta) {
+            delta = key[i] - change, di = i;
+         }
+      }
+
+      // case 1, a slack rounded below zero counts as tight
+      if (delta <= 1e-15 && matching[di] == -1) {
+         res.tree[di] = arg[di];
+         res.t.emplace_back(di, change);
+         res.start = di;
+         return res;
+      }
+
+      // case 2
+      if (delta <= 1e-15 && matching[di] != -1) {
+         int kj = matching[di];
+         res.tree[kj] = di, res.tree[di] = arg[di];
+         in_t[di] = true;
+         res.t.emplace_back(di, change), res.s.emplace_back(kj, change);
+         if (beta[kj] < epsilon) {
+            epsilon = beta[kj], ej = kj;
+         }
+         join(kj, nearest[kj] - beta[kj] - change);
+         continue;
+      }
+
+      // case 3
+      if (epsilon > delta) {
+         change += delta;
+         epsilon -= delta;
+         continue;
+      }
+
+      // case 4
+      if (delta >= epsilon) {
+         change += epsilon;
+         epsilon -= epsilon;
+         res.start = ej;
+         return res;
+      }
+   }
+}
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+   int threads = (argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency( )));
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      std::cin >> points[v].x >> points[v].y;
+   }
+   bool swapped = orient(a, b, points);
+
+   std::vector<int> closest_v(a + b);
+   std::vector<double> nearest(a + b, std::numeric_limits<double>::max( ));
+   for (int i = 0; i < a; ++i) {
+      for (int j = a; j < a + b; ++j) {
+         double d = distance(points[i], points[j]);
+         if (d < nearest[i]) {
+            nearest[i] = d;
+            closest_v[i] = j;
+         }
+         if (d < nearest[j]) {
+            nearest[j] = d;
+            closest_v[j] = i;
+         }
+      }
+   }
+
+   std::vector<int> matching(a + b, -1);
+   std::vector<double> alpha(a, 0);
+   std::vector<double> beta(a + b, std::numeric_limits<double>::lowest( ));
+   for (int j = a; j < a + b; ++j) {
+      for (int i = 0; i < a; ++i) {
+         beta[j] = std::max(beta[j], reduced_cost(i, j, points, nearest));
+      }
+   }
+
+   bad_queue bads(a, b, matching, beta);
+   std::vector<int> stamp(a + b, -1);
+   for (int round = 0; !limit.expired( ) && !bads.empty( ); ++round) {
+      // every worker grows a tree from its own bad against the duals of the previous round
+      std::vector<int> batch = bads.batch(threads, points);
+      std::vector<growth> grown(batch.size( ));
+      std::vector<std::thread> workers;
+      for (int w = 0; w < batch.size( ); ++w) {
+         workers.emplace_back([&, w] {
+            grown[w] = grow(batch[w], a, b, points, nearest, matching, alpha, beta, limit);
+         });
+      }
+      for (auto& worker : workers) {
+         worker.join( );
+      }
+
+      // trees that share a vertex with an earlier tree of the batch are discarded and retried
+      std::vector<int> accepted;
+      for (int w = 0; w < batch.size( ); ++w) {
+         bool conflict = (grown[w].start == -1);
+         for (const auto& side : { grown[w].t, grown[w].s }) {
+            for (auto [v, c] : side) {
+               conflict = conflict || stamp[v] == round;
+            }
+         }
+         if (!conflict) {
+            for (const auto& side : { grown[w].t, grown[w].s }) {
+               for (auto [v, c] : side) {
+                  stamp[v] = round;
+               }
+            }
+            accepted.push_back(w);
+         }
+      }
+
+      // disjoint trees touch disjoint duals and matching entries, so they commit in parallel
+      workers.clear( );
+      for (int w : accepted) {
+         workers.emplace_back([&, w] {
+            auto& g = grown[w];
+            for (auto [i, c] : g.t) {
+               alpha[i] += g.change - c;
+            }
+            for (auto [j, c] : g.s) {
+               beta[j] -= g.change - c;
+            }
+            update_matching(matching, g.tree, g.start, a, b);
+         });
+      }
+      for (auto& worker : workers) {
+         worker.join( );
+      }
+      for (int w : accepted) {
+         for (auto [j, c] : grown[w].s) {
+            bads.update(j, matching, beta);
+         }
+      }
+   }
+
+   // the duals must still satisfy the reduced-cost invariants of the sequential solvers, only a stopped run may leave bads
+   for (int i = 0; i < a; ++i) {
+      if (alpha[i] < -1e-9 || (matching[i] == -1 && alpha[i] > 1e-9)) {
+         throw std::logic_error("infeasible alpha");
+      }
+      for (int j = a; j < a + b; ++j) {
+         double slack = alpha[i] + beta[j] - reduced_cost(i, j, points, nearest);
+         if (slack < -1e-9 || (matching[i] == j && slack > 1e-9)) {
+            throw std::logic_error("duals do not certify optimality");
+         }
+      }
+   }
+   for (int j = a; j < a + b; ++j) {
+      if (beta[j] < -1e-9 || (matching[j] == -1 && beta[j] > 1e-9 && bads.empty( ))) {
+         throw std::logic_error("infeasible beta");
+      }
+   }
+
+   std::vector<std::pair<int, int>> used;
+   std::vector<bool> covered(a + b, false);
+   double total = 0;
+   for (int i = 0; i < a + b; ++i) {
+      if (!covered[i]) {
+         int matched = (i < a && matching[i] != -1 ? matching[i] : closest_v[i]);
+         used.emplace_back(i, matched);
+         covered[i] = covered[matched] = true;
+         total += distance(points[i], points[matched]);
+      }
+   }
+
+   std::cout << used.size( ) << "\n";
+   for (auto [p1, p2] : used) {
+      std::cout << original(p1, a, b, swapped) << " " << original(p2, a, b, swapped) << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (!bads.queue.empty( )) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v];
+      }
+      for (int i = 0; i < a; ++i) {
+         bound -= alpha[i];
+      }
+      for (int j = a; j < a + b; ++j) {
+         bound -= beta[j];
+      }
+      std::cout << "incomplete " << bound << " " << bads.queue.size( ) << "\n";
+   }
+} catch (...) {
+   return -1;
+}
@@ -0,0 +1,627 @@
+#include <boost/heap/fibonacci_heap.hpp>
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/Apollonius_graph_2.h>
+#include <CGAL/Apollonius_graph_traits_2.h>
+#include <CGAL/MP_Float.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using Apollonius_graph = CGAL::Apollonius_graph_2<CGAL::Apollonius_graph_traits_2<CGAL::Simple_cartesian<double>>>;
+
+struct point {
+   double x, y;
+
+   bool operator<(const point& p) const {
+      return x < p.x || (x == p.x && y < p.y);
+   }
+};
+
+struct edge {
+   int p1, p2;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y) {
+   std::uint64_t d = 0;
+   for (std::uint32_t s = 1u << 15; s > 0; s /= 2) {
+      std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+      d += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+         if (rx == 1) {
+            x = s - 1 - x, y = s - 1 - y;
+         }
+         std::swap(x, y);
+      }
+   }
+   return d;
+}
+
+double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
+   return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
+}
+
+bool orient(int& a, int& b, std::vector<point>& points) {
+   // every phase grows a tree from a bad of B, and nearly every point starts bad: the edge from v to its nearest point u has
+   // reduced cost nearest[u], zero only when u coincides with a point of the other side; so B should be the smaller side
+   if (a < b) {
+      std::rotate(points.begin( ), points.begin( ) + a, points.end( ));
+      std::swap(a, b);
+      return true;
+   }
+   return false;
+}
+
+int original(int v, int a, int b, bool swapped) {
+   // after a swap the first a points are the original B
+   return (!swapped ? v : v < a ? v + b : v - a);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
+      if (matching[j] == -1 && beta[j] > 1e-15) {
+         queue.emplace(key[j] = beta[j], j);
+      }
+   }
+   int top( ) const {
+      return (queue.empty( ) ? -1 : queue.begin( )->second);
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1)
+   std::vector<int> members, position;
+   int first;
+
+   vertex_set(int n, int f = 0)
+   : position(n, -1), first(f) {
+   }
+   void insert(int v) {
+      if (position[v - first] == -1) {
+         position[v - first] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = position[v - first]; p != -1) {
+         position[members.back( ) - first] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v - first] = -1;
+      }
+   }
+   bool contains(int v) const {
+      return position[v - first] != -1;
+   }
+   void merge(vertex_set& other) {
+      for (int v : other.members) {
+         insert(v);
+      }
+      other.clear( );
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v - first] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+   int size( ) const {
+      return members.size( );
+   }
+   bool empty( ) const {
+      return members.empty( );
+   }
+};
+
+void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
+   static std::vector<std::pair<int, int>> path;      // scratch reused by every phase
+   path.clear( );
+   for (int p = start; tree[p] != -1; p = tree[p]) {
+      path.emplace_back(p, tree[p]);
+   }
+   for (int c = 1 - path.size( ) % 2; c < path.size( ); c += 2) {
+      for (int p : { path[c].first, path[c].second }) {
+         if (matching[p] != -1) {
+            matching[matching[p]] = -1;
+         }
+      }
+      matching[path[c].first] = path[c].second;
+      matching[path[c].second] = path[c].first;
+   }
+}
+
+struct mapping {
+   const std::vector<point>& points;
+   const std::vector<double>& weight;
+   std::multimap<point, int> indices;
+   std::vector<std::uint64_t> order;
+
+   mapping(const std::vector<point>& p, const std::vector<double>& w)
+   : points(p), weight(w), order(p.size( )) {
+      for (int v = 0; v < points.size( ); ++v) {
+         indices.emplace(points[v], v);
+      }
+
+      // position of every point along a Hilbert curve over the bounding box
+      auto [min_x, max_x] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [min_y, max_y] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      double side = std::max({ max_x->x - min_x->x, max_y->y - min_y->y, 1e-9 });
+      for (int v = 0; v < points.size( ); ++v) {
+         order[v] = hilbert_index((points[v].x - min_x->x) / side * 65535, (points[v].y - min_y->y) / side * 65535);
+      }
+   }
+};
+
+struct voronoi_diagram {
+   static inline double construction = 0;      // seconds spent in bulk_insert over the whole run
+   Apollonius_graph diagrama;
+   std::map<int, double> sites;
+
+   voronoi_diagram( ) = default;
+   voronoi_diagram(const std::vector<int>& set, const mapping& m) {
+      insert(set, m);
+   }
+   void insert(const std::vector<int>& set, const mapping& m) {
+      std::vector<std::pair<int, double>> batch;
+      for (int v : set) {
+         sites.emplace(v, m.weight[v]);
+         batch.emplace_back(v, m.weight[v]);
+      }
+      bulk_insert(std::move(batch), m);
+   }
+   void bulk_insert(std::vector<std::pair<int, double>> batch, const mapping& m) {
+      auto start = std::chrono::steady_clock::now( );
+      // Hilbert order keeps consecutive sites close, so each point location starts from the previous vertex
+      std::sort(batch.begin( ), batch.end( ), [&](auto elem1, auto elem2) {
+         return m.order[elem1.first] < m.order[elem2.first];
+      });
+      Apollonius_graph::Vertex_handle hint;
+      for (auto [v, w] : batch) {
+         Apollonius_graph::Site_2 site({ m.points[v].x, m.points[v].y }, w);
+         auto vertex = (hint == Apollonius_graph::Vertex_handle( ) ? diagrama.insert(site) : diagrama.insert(site, hint));
+         if (vertex != Apollonius_graph::Vertex_handle( )) {
+            hint = vertex;
+         }
+      }
+      construction += std::chrono::duration<double>(std::chrono::steady_clock::now( ) - start).count( );
+   }
+   void insert(int v, const mapping& m) {
+      sites.emplace(v, m.weight[v]);
+      diagrama.insert({ { m.points[v].x, m.points[v].y }, m.weight[v] });
+   }
+   void erase(int v, const mapping& m) {
+      auto vertex = diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y });
+      bool visible = (index(vertex, m) == v);
+      sites.erase(v);
+      if (visible) {
+         diagrama.remove(vertex);
+      } else {
+         // hidden sites cannot be removed from an Apollonius graph, rebuild without it
+         diagrama.clear( );
+         bulk_insert({ sites.begin( ), sites.end( ) }, m);
+      }
+   }
+   int find(int v, const mapping& m) {
+      return index(diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y }), m);
+   }
+   std::vector<std::pair<int, int>> find(std::vector<int> queries, const mapping& m) {
+      // queries in Hilbert order, so each walk starts from the answer to the previous, nearby query
+      std::sort(queries.begin( ), queries.end( ), [&](int v1, int v2) {
+         return m.order[v1] < m.order[v2];
+      });
+      std::vector<std::pair<int, int>> res;
+      Apollonius_graph::Vertex_handle hint;
+      for (int v : queries) {
+         Apollonius_graph::Point_2 p(m.points[v].x, m.points[v].y);
+         hint = (hint == Apollonius_graph::Vertex_handle( ) ? diagrama.nearest_neighbor(p) : diagrama.nearest_neighbor(p, hint));
+         res.emplace_back(v, index(hint, m));
+      }
+      return res;
+   }
+   int index(Apollonius_graph::Vertex_handle vertex, const mapping& m) const {
+      // points may repeat, the site is the member of this diagram at its position that hides the others there
+      auto res = vertex->site( );
+      auto [from, to] = m.indices.equal_range(point{CGAL::to_double(res.x( )), CGAL::to_double(res.y( ))});
+      int best = -1;
+      for (auto it = from; it != to; ++it) {
+         if (auto site = sites.find(it->second); site != sites.end( ) && (best == -1 || site->second > sites.at(best))) {
+            best = it->second;
+         }
+      }
+      return best;
+   }
+   bool empty( ) const {
+      return diagrama.number_of_vertices( ) == 0;
+   }
+};
+
+struct logarithmic_diagram {
+   // Bentley-Saxe decomposition of F: level k is a static diagram built over at most 2^k sites
+   std::vector<voronoi_diagram> levels;
+   std::vector<int> where;       // level of the live copy of every site, -1 if deleted
+   int live = 0, stored = 0;
+
+   logarithmic_diagram(const std::vector<int>& set, int n, const mapping& m)
+   : where(n, -1) {
+      build({ set.begin( ), set.end( ) }, m);
+   }
+   void build(const std::vector<int>& all, const mapping& m) {
+      levels.clear( ), stored = live = 0;
+      for (int k = 0, c = 0; c < all.size( ); ++k) {
+         levels.emplace_back( );
+         if (all.size( ) >> k & 1) {
+            std::vector<int> set(all.begin( ) + c, all.begin( ) + c + (1 << k));
+            place(k, set, m), c += 1 << k;
+         }
+      }
+   }
+   void place(int k, const std::vector<int>& set, const mapping& m) {
+      levels[k] = voronoi_diagram(set, m);
+      for (int v : set) {
+         where[v] = k;
+      }
+      stored += set.size( ), live += set.size( );
+   }
+   std::vector<int> take(int k) {
+      std::vector<int> res;
+      for (auto [v, w] : levels[k].sites) {
+         if (where[v] == k) {
+            res.push_back(v);
+         }
+      }
+      stored -= levels[k].sites.size( ), live -= res.size( );
+      levels[k] = voronoi_diagram( );
+      return res;
+   }
+   void insert(int v, const mapping& m) {
+      // binary counter: the full lower levels and v are rebuilt into the first empty level
+      std::vector<int> carry = { v };
+      int k = 0;
+      for (; k < levels.size( ) && !levels[k].sites.empty( ); ++k) {
+         for (int u : take(k)) {
+            carry.push_back(u);
+         }
+      }
+      if (k == levels.size( )) {
+         levels.emplace_back( );
+      }
+      place(k, carry, m);
+   }
+   void erase(int v, const mapping& m) {
+      // tombstone: a visible copy is removed right away, a hidden one is purged by the query that exposes it
+      auto& level = levels[where[v]];
+      if (auto vertex = level.diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y }); level.index(vertex, m) == v) {
+         level.diagrama.remove(vertex), level.sites.erase(v), stored -= 1;
+      }
+      where[v] = -1, live -= 1;
+      if (stored > 2 * live) {
+         std::vector<int> all;
+         for (int k = 0; k < levels.size( ); ++k) {
+            for (int u : take(k)) {
+               all.push_back(u);
+            }
+         }
+         build(all, m);
+      }
+   }
+   int find(int v, const mapping& m) {
+      int res = -1;
+      for (int k = 0; k < levels.size( ); ++k) {
+         for (auto& level = levels[k]; !level.empty( );) {
+            auto vertex = level.diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y });
+            if (int i = level.index(vertex, m); where[i] != k) {
+               level.diagrama.remove(vertex), level.sites.erase(i), stored -= 1;
+            } else {
+               if (res == -1 || distance(m.points[i], m.points[v]) - m.weight[i] < distance(m.points[res], m.points[v]) - m.weight[res]) {
+                  res = i;
+               }
+               break;
+            }
+         }
+      }
+      return res;
+   }
+};
+
+struct min_heap {
+   boost::heap::fibonacci_heap<std::tuple<double, int, int>, boost::heap::compare<std::greater<>>> heap;
+   std::vector<std::vector<decltype(heap)::handle_type>> handles;
+
+   min_heap(int a, int b)
+   : handles(a) {
+   }
+   void push(int i, int j, const mapping& m) {
+      handles[i].push_back(heap.emplace(distance(m.points[i], m.points[j]) - m.weight[i] - m.weight[j], i, j));
+   }
+   std::vector<int> erase(int i) {
+      std::vector<int> res;
+      for (; !handles[i].empty( ); handles[i].pop_back( )) {
+         res.push_back(std::get<2>(*handles[i].back( )));
+         heap.erase(handles[i].back( ));
+      }
+      return res;
+   }
+   void clear( ) {
+      // only the handle lists of queued entries are reset, their storage is kept for the next phase
+      for (auto [d, i, j] : heap) {
+         handles[i].clear( );
+      }
+      heap.clear( );
+   }
+   std::tuple<double, int, int> top( ) const {
+      return heap.top( );
+   }
+   bool empty( ) const {
+      return heap.empty( );
+   }
+};
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      std::cin >> points[v].x >> points[v].y;
+   }
+   bool swapped = orient(a, b, points);
+
+   std::vector<int> closest_v(a + b);
+   std::vector<double> nearest(a + b, std::numeric_limits<double>::max( ));
+   for (int i = 0; i < a; ++i) {
+      for (int j = a; j < a + b; ++j) {
+         double d = distance(points[i], points[j]);
+         if (d < nearest[i]) {
+            nearest[i] = d;
+            closest_v[i] = j;
+         }
+         if (d < nearest[j]) {
+            nearest[j] = d;
+            closest_v[j] = i;
+         }
+      }
+   }
+
+   std::vector<int> matching(a + b, -1);
+   std::vector<double> alpha(a, 0);
+   std::vector<double> beta(a + b, std::numeric_limits<double>::lowest( ));
+   for (int j = a; j < a + b; ++j) {
+      for (int i = 0; i < a; ++i) {
+         beta[j] = std::max(beta[j], reduced_cost(i, j, points, nearest));
+      }
+   }
+
+   int h = std::ceil(std::sqrt(a));
+   vertex_set f(a);
+   for (int i = 0; i < a; ++i) {
+      f.insert(i);
+   }
+
+   std::vector<double> weight(a + b);
+   for (int i = 0; i < a; ++i) {
+      weight[i] = nearest[i] - alpha[i];
+   }
+   for (int j = a; j < a + b; ++j) {
+      weight[j] = nearest[j] - beta[j];
+   }
+
+   mapping m(points, weight);
+   logarithmic_diagram voronoi_f(f.members, a, m);
+
+   // scratch that outlives the phases, each phase resets only what it touched
+   vertex_set s1(a + b), s2(a + b), t(a);
+   std::vector<int> tree(a + b, -1);
+   min_heap heap_f_s1(a, b), heap_s2_f(a, b);
+
+   bad_queue bads(a, b, matching, beta);
+   for (int rj; !limit.expired( ) && (rj = bads.top( )) != -1; s1.clear( ), s2.clear( ), t.clear( )) {
+      int ej = rj; double epsilon = beta[ej];
+      s1.insert(rj); int f_tam = a;
+      double change = 0;
+
+      voronoi_diagram voronoi_s1(s1.members, m);
+
+      heap_f_s1.clear( ), heap_s2_f.clear( );
+      auto fill_f_s1 = [&] {
+         for (auto [i, j] : voronoi_s1.find({ f.begin( ), f.end( ) }, m)) {
+            heap_f_s1.push(i, j, m);
+         }
+      };
+      fill_f_s1( );
+      for (int j : s2) {
+         heap_s2_f.push(voronoi_f.find(j, m), j, m);
+      }
+
+      for (;;) {
+         if (limit.expired( )) {
+            // the tree alive at the deadline is dropped as it stands, its duals are feasible already
+            break;
+         }
+
+         double delta = std::numeric_limits<double>::max( ); int di, dj;
+         for (auto heap : { &heap_f_s1, &heap_s2_f }) {
+            if (!heap->empty( )) {
+               if (auto [d, i, j] = heap->top( ); delta > d) {
+                  delta = d, di = i, dj = j;
+               }
+            }
+         }
+         delta -= change;
+
+         // case 1, a slack rounded below zero counts as tight
+         if (delta <= 1e-15 && matching[di] == -1) {
+            tree[di] = dj;
+            f.erase(di), t.insert(di), f_tam -= 1;
+            weight[di] += change;
+            voronoi_f.erase(di, m);
+            update_matching(matching, tree, di, a, b);
+            break;
+         }
+
+         // case 2
+         if (delta <= 1e-15 && matching[di] != -1) {
+            int kj = matching[di];
+            tree[kj] = di, tree[di] = dj;
+            f.erase(di), t.insert(di), s2.insert(kj), f_tam -= 1;
+            weight[di] += change, weight[kj] -= change;
+            if (beta[kj] < epsilon) {
+               epsilon = beta[kj], ej = kj;
+            }
+
+            voronoi_f.erase(di, m);
+            if (s2.size( ) <= h) {
+               // only the s2 vertices whose nearest site was di need a new one
+               heap_f_s1.erase(di);
+               for (int j : heap_s2_f.erase(di)) {
+                  if (int i = voronoi_f.find(j, m); i != -1) {
+                     heap_s2_f.push(i, j, m);
+                  }
+               }
+               if (int i = voronoi_f.find(kj, m); i != -1) {
+                  heap_s2_f.push(i, kj, m);
+               }
+            } else {
+               voronoi_s1.insert(s2.members, m);
+               s1.merge(s2);
+               heap_f_s1.clear( ), heap_s2_f.clear( );
+               fill_f_s1( );
+            }
+            continue;
+         }
+
+         // case 3
+         if (epsilon > delta) {
+            change += delta;
+            epsilon -= delta;
+            continue;
+         }
+
+         // case 4
+         if (delta >= epsilon) {
+            change += epsilon;
+            epsilon -= epsilon;
+            update_matching(matching, tree, ej, a, b);
+            break;
+         }
+      }
+
+      for (int i : t) {
+         weight[i] -= change;
+         alpha[i] = nearest[i] - weight[i];
+         f.insert(i), voronoi_f.insert(i, m);
+      }
+      for (auto s : { &s1, &s2 }) {
+         for (int j : *s) {
+            weight[j] += change;
+            beta[j] = nearest[j] - weight[j];
+            tree[j] = -1;
+            bads.update(j, matching, beta);
+         }
+      }
+   }
+
+   std::cerr << "diagram construction " << voronoi_diagram::construction << " s\n";
+
+   std::vector<edge> used;
+   std::vector<bool> covered(a + b, false);
+   double total = 0;
+   for (int i = 0; i < a + b; ++i) {
+      if (!covered[i]) {
+         int matched = (i < a && matching[i] != -1 ? matching[i] : closest_v[i]);
+         used.emplace_back(i, matched);
+         covered[i] = true;
+         covered[matched] = true;
+         total += distance(points[i], points[matched]);
+      }
+   }
+
+   std::cout << used.size( ) << "\n";
+   for (auto [p1, p2] : used) {
+      std::cout << original(p1, a, b, swapped) << " " << original(p2, a, b, swapped) << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (!bads.queue.empty( )) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v];
+      }
+      for (int i = 0; i < a; ++i) {
+         bound -= alpha[i];
+      }
+      for (int j = a; j < a + b; ++j) {
+         bound -= beta[j];
+      }
+      std::cout << "incomplete " << bound << " " << bads.queue.size( ) << "\n";
+   }
+} catch (const std::exception& ex) {
+   return -1;
+}
\ No newline at end of file
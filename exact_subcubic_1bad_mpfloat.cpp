@@ -5,7 +5,10 @@
 #include <CGAL/MP_Float.h>
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <csignal>
+#include <cstdint>
 #include <deque>
 #include <exception>
 #include <functional>
@@ -14,6 +17,7 @@
 #include <limits>
 #include <map>
 #include <set>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -41,21 +45,116 @@ double distance(const point& p1, const point& p2) {
    return std::sqrt(distance_magnitude(p1, p2));
 }
 
+std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y) {
+   std::uint64_t d = 0;
+   for (std::uint32_t s = 1u << 15; s > 0; s /= 2) {
+      std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+      d += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+         if (rx == 1) {
+            x = s - 1 - x, y = s - 1 - y;
+         }
+         std::swap(x, y);
+      }
+   }
+   return d;
+}
+
 double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
    return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
 }
 
-int find_bad(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta) {
-   for (int j = a; j < a + b; ++j) {
+bool orient(int& a, int& b, std::vector<point>& points) {
+   // every phase grows a tree from a bad of B, and nearly every point starts bad: the edge from v to its nearest point u has
+   // reduced cost nearest[u], zero only when u coincides with a point of the other side; so B should be the smaller side
+   if (a < b) {
+      std::rotate(points.begin( ), points.begin( ) + a, points.end( ));
+      std::swap(a, b);
+      return true;
+   }
+   return false;
+}
+
+int original(int v, int a, int b, bool swapped) {
+   // after a swap the first a points are the original B
+   return (!swapped ? v : v < a ? v + b : v - a);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
       if (matching[j] == -1 && beta[j] > 1e-15) {
-         return j;
+         queue.emplace(key[j] = beta[j], j);
       }
    }
-   return -1;
-}
+   int top( ) const {
+      return (queue.empty( ) ? -1 : queue.begin( )->second);
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1)
+   std::vector<int> members, position;
+   int first;
+
+   vertex_set(int n, int f = 0)
+   : position(n, -1), first(f) {
+   }
+   void insert(int v) {
+      if (position[v - first] == -1) {
+         position[v - first] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = position[v - first]; p != -1) {
+         position[members.back( ) - first] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v - first] = -1;
+      }
+   }
+   bool contains(int v) const {
+      return position[v - first] != -1;
+   }
+   void merge(vertex_set& other) {
+      for (int v : other.members) {
+         insert(v);
+      }
+      other.clear( );
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v - first] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+   int size( ) const {
+      return members.size( );
+   }
+   bool empty( ) const {
+      return members.empty( );
+   }
+};
 
 void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
-   std::vector<std::pair<int, int>> path;
+   static std::vector<std::pair<int, int>> path;      // scratch reused by every phase
+   path.clear( );
    for (int p = start; tree[p] != -1; p = tree[p]) {
       path.emplace_back(p, tree[p]);
    }
@@ -73,31 +172,106 @@ void update_matching(std::vector<int>& matching, std::vector<int>& tree, int sta
 struct mapping {
    const std::vector<point>& points;
    const std::vector<double>& weight;
-   std::map<point, int> indices;
+   std::multimap<point, int> indices;
+   std::vector<std::uint64_t> order;
 
    mapping(const std::vector<point>& p, const std::vector<double>& w)
-   : points(p), weight(w) {
+   : points(p), weight(w), order(p.size( )) {
       for (int v = 0; v < points.size( ); ++v) {
          indices.emplace(points[v], v);
       }
+
+      // position of every point along a Hilbert curve over the bounding box
+      auto [min_x, max_x] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [min_y, max_y] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      double side = std::max({ max_x->x - min_x->x, max_y->y - min_y->y, 1e-9 });
+      for (int v = 0; v < points.size( ); ++v) {
+         order[v] = hilbert_index((points[v].x - min_x->x) / side * 65535, (points[v].y - min_y->y) / side * 65535);
+      }
    }
 };
 
 struct voronoi_diagram {
+   static inline double construction = 0;      // seconds spent in bulk_insert over the whole run
    Apollonius_graph diagrama;
+   std::map<int, double> sites;
 
    voronoi_diagram( ) = default;
-   voronoi_diagram(const std::set<int>& set, const mapping& m) {
+   voronoi_diagram(const std::vector<int>& set, const mapping& m) {
       insert(set, m);
    }
-   void insert(const std::set<int>& set, const mapping& m) {
+   void insert(const std::vector<int>& set, const mapping& m) {
+      std::vector<std::pair<int, double>> batch;
       for (int v : set) {
-         diagrama.insert({ { m.points[v].x, m.points[v].y }, m.weight[v] });
+         sites.emplace(v, m.weight[v]);
+         batch.emplace_back(v, m.weight[v]);
+      }
+      bulk_insert(std::move(batch), m);
+   }
+   void bulk_insert(std::vector<std::pair<int, double>> batch, const mapping& m) {
+      auto start = std::chrono::steady_clock::now( );
+      // Hilbert order keeps consecutive sites close, so each point location starts from the previous vertex
+      std::sort(batch.begin( ), batch.end( ), [&](auto elem1, auto elem2) {
+         return m.order[elem1.first] < m.order[elem2.first];
+      });
+      Apollonius_graph::Vertex_handle hint;
+      for (auto [v, w] : batch) {
+         Apollonius_graph::Site_2 site({ m.points[v].x, m.points[v].y }, w);
+         auto vertex = (hint == Apollonius_graph::Vertex_handle( ) ? diagrama.insert(site) : diagrama.insert(site, hint));
+         if (vertex != Apollonius_graph::Vertex_handle( )) {
+            hint = vertex;
+         }
+      }
+      construction += std::chrono::duration<double>(std::chrono::steady_clock::now( ) - start).count( );
+   }
+   void insert(int v, const mapping& m) {
+      sites.emplace(v, m.weight[v]);
+      diagrama.insert({ { m.points[v].x, m.points[v].y }, m.weight[v] });
+   }
+   void erase(int v, const mapping& m) {
+      auto vertex = diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y });
+      bool visible = (index(vertex, m) == v);
+      sites.erase(v);
+      if (visible) {
+         diagrama.remove(vertex);
+      } else {
+         // hidden sites cannot be removed from an Apollonius graph, rebuild without it
+         diagrama.clear( );
+         bulk_insert({ sites.begin( ), sites.end( ) }, m);
       }
    }
    int find(int v, const mapping& m) {
-      auto res = diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y })->site( );
-      return m.indices.find(point{CGAL::to_double(res.x( )), CGAL::to_double(res.y( ))})->second;
+      return index(diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y }), m);
+   }
+   std::vector<std::pair<int, int>> find(std::vector<int> queries, const mapping& m) {
+      // queries in Hilbert order, so each walk starts from the answer to the previous, nearby query
+      std::sort(queries.begin( ), queries.end( ), [&](int v1, int v2) {
+         return m.order[v1] < m.order[v2];
+      });
+      std::vector<std::pair<int, int>> res;
+      Apollonius_graph::Vertex_handle hint;
+      for (int v : queries) {
+         Apollonius_graph::Point_2 p(m.points[v].x, m.points[v].y);
+         hint = (hint == Apollonius_graph::Vertex_handle( ) ? diagrama.nearest_neighbor(p) : diagrama.nearest_neighbor(p, hint));
+         res.emplace_back(v, index(hint, m));
+      }
+      return res;
+   }
+   int index(Apollonius_graph::Vertex_handle vertex, const mapping& m) const {
+      // points may repeat, the site is the member of this diagram at its position that hides the others there
+      auto res = vertex->site( );
+      auto [from, to] = m.indices.equal_range(point{CGAL::to_double(res.x( )), CGAL::to_double(res.y( ))});
+      int best = -1;
+      for (auto it = from; it != to; ++it) {
+         if (auto site = sites.find(it->second); site != sites.end( ) && (best == -1 || site->second > sites.at(best))) {
+            best = it->second;
+         }
+      }
+      return best;
    }
    bool empty( ) const {
       return diagrama.number_of_vertices( ) == 0;
@@ -120,8 +294,11 @@ struct min_heap {
       }
    }
    void clear( ) {
+      // only the handle lists of queued entries are reset, their storage is kept for the next phase
+      for (auto [d, i, j] : heap) {
+         handles[i].clear( );
+      }
       heap.clear( );
-      handles = std::vector<std::vector<decltype(heap)::handle_type>>(handles.size( ));
    }
    std::tuple<double, int, int> top( ) const {
       return heap.top( );
@@ -131,7 +308,32 @@ struct min_heap {
    }
 };
 
-int main( ) try {
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+
    int a, b;
    std::cin >> a >> b;
 
@@ -139,6 +341,7 @@ int main( ) try {
    for (int v = 0; v < a + b; ++v) {
       std::cin >> points[v].x >> points[v].y;
    }
+   bool swapped = orient(a, b, points);
 
    std::vector<int> closest_v(a + b);
    std::vector<double> nearest(a + b, std::numeric_limits<double>::max( ));
@@ -166,37 +369,52 @@ int main( ) try {
    }
 
    int h = std::ceil(std::sqrt(a));
-   for (int rj; (rj = find_bad(a, b, matching, beta)) != -1;) {
-      int ej = rj; double epsilon = beta[ej];
-      std::set<int> s1 = { rj }, s2, t;
-      std::vector<std::set<int>> fi(h); int f_tam = a;
-      for (int i = 0; i < a; ++i) {
-         fi[i / h].insert(i);
-      }
-      std::vector<int> tree(a + b, -1);
+   std::vector<vertex_set> fi;
+   for (int hi = 0; hi < h; ++hi) {
+      fi.emplace_back(h, hi * h);
+   }
+   for (int i = 0; i < a; ++i) {
+      fi[i / h].insert(i);
+   }
 
-      std::vector<double> weight(a + b);
-      for (int i = 0; i < a; ++i) {
-         weight[i] = nearest[i] - alpha[i];
-      }
-      for (int j = a; j < a + b; ++j) {
-         weight[j] = nearest[j] - beta[j];
-      }
+   std::vector<double> weight(a + b);
+   for (int i = 0; i < a; ++i) {
+      weight[i] = nearest[i] - alpha[i];
+   }
+   for (int j = a; j < a + b; ++j) {
+      weight[j] = nearest[j] - beta[j];
+   }
+
+   mapping m(points, weight);
+   std::vector<voronoi_diagram> voronoi_fi(h);
+   for (int hi = 0; hi < h; ++hi) {
+      voronoi_fi[hi] = voronoi_diagram(fi[hi].members, m);
+   }
+
+   // scratch that outlives the phases, each phase resets only what it touched
+   vertex_set s1(a + b), s2(a + b), t(a);
+   std::vector<int> tree(a + b, -1);
+   min_heap heap_f_s1(a, b), heap_s2_f(a, b);
+
+   bad_queue bads(a, b, matching, beta);
+   for (int rj; !limit.expired( ) && (rj = bads.top( )) != -1; s1.clear( ), s2.clear( ), t.clear( )) {
+      int ej = rj; double epsilon = beta[ej];
+      s1.insert(rj); int f_tam = a;
       double change = 0;
 
-      mapping m(points, weight);
-      voronoi_diagram voronoi_s1(s1, m);
-      std::vector<voronoi_diagram> voronoi_fi(h);
-      for (int hi = 0; hi < h; ++hi) {
-         voronoi_fi[hi] = voronoi_diagram(fi[hi], m);
-      }
+      voronoi_diagram voronoi_s1(s1.members, m);
 
-      min_heap heap_f_s1(a, b), heap_s2_f(a, b);
-      for (int hi = 0; hi < h; ++hi) {
-         for (int i : fi[hi]) {
-            heap_f_s1.push(i, voronoi_s1.find(i, m), m);
+      heap_f_s1.clear( ), heap_s2_f.clear( );
+      auto fill_f_s1 = [&] {
+         std::vector<int> queries;
+         for (int hi = 0; hi < h; ++hi) {
+            queries.insert(queries.end( ), fi[hi].begin( ), fi[hi].end( ));
          }
-      }
+         for (auto [i, j] : voronoi_s1.find(std::move(queries), m)) {
+            heap_f_s1.push(i, j, m);
+         }
+      };
+      fill_f_s1( );
       for (int j : s2) {
          for (int hi = 0; hi < h; ++hi) {
             heap_s2_f.push(voronoi_fi[hi].find(j, m), j, m);
@@ -204,6 +422,11 @@ int main( ) try {
       }
 
       for (;;) {
+         if (limit.expired( )) {
+            // the tree alive at the deadline is dropped as it stands, its duals are feasible already
+            break;
+         }
+
          double delta = std::numeric_limits<double>::max( ); int di, dj;
          for (auto heap : { &heap_f_s1, &heap_s2_f }) {
             if (!heap->empty( )) {
@@ -214,17 +437,18 @@ int main( ) try {
          }
          delta -= change;
 
-         // case 1
-         if (std::abs(delta) <= 1e-15 && matching[di] == -1) {
+         // case 1, a slack rounded below zero counts as tight
+         if (delta <= 1e-15 && matching[di] == -1) {
             tree[di] = dj;
             fi[di / h].erase(di), t.insert(di), f_tam -= 1;
             weight[di] += change;
+            voronoi_fi[di / h].erase(di, m);
             update_matching(matching, tree, di, a, b);
             break;
          }
 
          // case 2
-         if (std::abs(delta) <= 1e-15 && matching[di] != -1) {
+         if (delta <= 1e-15 && matching[di] != -1) {
             int kj = matching[di];
             tree[kj] = di, tree[di] = dj;
             fi[di / h].erase(di), t.insert(di), s2.insert(kj), f_tam -= 1;
@@ -233,7 +457,7 @@ int main( ) try {
                epsilon = beta[kj], ej = kj;
             }
 
-            voronoi_fi[di / h] = voronoi_diagram(fi[di / h], m);
+            voronoi_fi[di / h].erase(di, m);
             if (s2.size( ) <= h) {
                heap_f_s1.erase(di), heap_s2_f.erase(di);
                for (int j : s2) {
@@ -247,14 +471,10 @@ int main( ) try {
                   }
                }
             } else {
-               voronoi_s1.insert(s2, m);
-               s1.merge(std::move(s2));
+               voronoi_s1.insert(s2.members, m);
+               s1.merge(s2);
                heap_f_s1.clear( ), heap_s2_f.clear( );
-               for (int hi = 0; hi < h; ++hi) {
-                  for (int i : fi[hi]) {
-                     heap_f_s1.push(i, voronoi_s1.find(i, m), m);
-                  }
-               }
+               fill_f_s1( );
             }
             continue;
          }
@@ -276,15 +496,22 @@ int main( ) try {
       }
 
       for (int i : t) {
-         alpha[i] = nearest[i] - weight[i] + change;
+         weight[i] -= change;
+         alpha[i] = nearest[i] - weight[i];
+         fi[i / h].insert(i), voronoi_fi[i / h].insert(i, m);
       }
-      for (const auto& s : { s1, s2 }) {
-         for (int j : s) {
-            beta[j] = nearest[j] - weight[j] - change;
+      for (auto s : { &s1, &s2 }) {
+         for (int j : *s) {
+            weight[j] += change;
+            beta[j] = nearest[j] - weight[j];
+            tree[j] = -1;
+            bads.update(j, matching, beta);
          }
       }
    }
 
+   std::cerr << "diagram construction " << voronoi_diagram::construction << " s\n";
+
    std::vector<edge> used;
    std::vector<bool> covered(a + b, false);
    double total = 0;
@@ -300,9 +527,23 @@ int main( ) try {
 
    std::cout << used.size( ) << "\n";
    for (auto [p1, p2] : used) {
-      std::cout << p1 << " " << p2 << "\n";
+      std::cout << original(p1, a, b, swapped) << " " << original(p2, a, b, swapped) << "\n";
    }
    std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (!bads.queue.empty( )) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v];
+      }
+      for (int i = 0; i < a; ++i) {
+         bound -= alpha[i];
+      }
+      for (int j = a; j < a + b; ++j) {
+         bound -= beta[j];
+      }
+      std::cout << "incomplete " << bound << " " << bads.queue.size( ) << "\n";
+   }
 } catch (const std::exception& ex) {
    return -1;
 }
\ No newline at end of file
@@ -5,15 +5,25 @@
 #include <CGAL/MP_Float.h>
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <deque>
 #include <exception>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <set>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -41,22 +51,162 @@ double distance(const point& p1, const point& p2) {
    return std::sqrt(distance_magnitude(p1, p2));
 }
 
+std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y) {
+   std::uint64_t d = 0;
+   for (std::uint32_t s = 1u << 15; s > 0; s /= 2) {
+      std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+      d += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+         if (rx == 1) {
+            x = s - 1 - x, y = s - 1 - y;
+         }
+         std::swap(x, y);
+      }
+   }
+   return d;
+}
+
 double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
    return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
 }
 
-std::set<int> find_bads(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta) {
-   std::set<int> res;
-   for (int j = a; j < a + b; ++j) {
+bool orient(int& a, int& b, std::vector<point>& points) {
+   // every phase grows a tree from a bad of B, and nearly every point starts bad: the edge from v to its nearest point u has
+   // reduced cost nearest[u], zero only when u coincides with a point of the other side; so B should be the smaller side
+   if (a < b) {
+      std::rotate(points.begin( ), points.begin( ) + a, points.end( ));
+      std::swap(a, b);
+      return true;
+   }
+   return false;
+}
+
+int original(int v, int a, int b, bool swapped) {
+   // after a swap the first a points are the original B
+   return (!swapped ? v : v < a ? v + b : v - a);
+}
+
+struct bad_queue {
+   std::set<std::pair<double, int>> queue;
+   std::vector<double> key;
+
+   bad_queue(int a, int b, const std::vector<int>& matching, const std::vector<double>& beta)
+   : key(a + b, 0) {
+      for (int j = a; j < a + b; ++j) {
+         update(j, matching, beta);
+      }
+   }
+   void update(int j, const std::vector<int>& matching, const std::vector<double>& beta) {
+      queue.erase({ key[j], j });      // no-op when j was not queued, queued keys are positive
       if (matching[j] == -1 && beta[j] > 1e-15) {
-         res.insert(j);
+         queue.emplace(key[j] = beta[j], j);
       }
    }
-   return res;
-}
+};
+
+struct bad_policy {
+   // which bads seed the next phase: all of them, the k largest betas, the next k along a sweep in x,
+   // the largest beta with its k - 1 nearest bads, or the largest betas in a batch that adapts to the phase cost
+   std::string name;
+   int k, phase = 0;
+   double sweep = std::numeric_limits<double>::lowest( ), last = std::numeric_limits<double>::max( );
+
+   bad_policy(int argc, char* argv[])
+   : name(argc > 1 ? argv[1] : "all"), k(argc > 2 ? std::stoi(argv[2]) : 1) {
+      if (name != "all" && name != "beta" && name != "sweep" && name != "cluster" && name != "adaptive" || k < 1) {
+         throw std::invalid_argument("unknown bad policy");
+      }
+   }
+   std::vector<int> next(const bad_queue& bads, const std::vector<point>& points) {
+      // beta and adaptive read only the k largest betas off the queue, sweep and cluster have to look at every bad
+      int take = (name == "beta" || name == "adaptive" ? k : bads.queue.size( ));
+      std::vector<int> all;
+      for (auto it = bads.queue.rbegin( ); it != bads.queue.rend( ) && all.size( ) < take; ++it) {
+         all.push_back(it->second);
+      }
+      if (name == "all" || all.size( ) <= k) {
+         return all;
+      }
+      if (name == "sweep") {
+         std::sort(all.begin( ), all.end( ), [&](int j1, int j2) {
+            return points[j1].x < points[j2].x;
+         });
+         std::rotate(all.begin( ), std::find_if(all.begin( ), all.end( ), [&](int j) {
+            return points[j].x >= sweep;
+         }), all.end( ));
+         sweep = std::nextafter(points[all[k - 1]].x, std::numeric_limits<double>::max( ));
+      } else if (name == "cluster") {
+         std::nth_element(all.begin( ) + 1, all.begin( ) + k - 1, all.end( ), [&](int j1, int j2) {
+            return distance(points[j1], points[all[0]]) < distance(points[j2], points[all[0]]);
+         });
+      }
+      all.resize(k);
+      return all;
+   }
+   void report(int seeded, int tree, double seconds) {
+      std::cerr << "phase " << ++phase << ": " << seeded << " bads, tree size " << tree << ", " << seconds << " s\n";
+      if (name == "adaptive") {
+         // the batch keeps doubling while the time per seeded bad does not get worse
+         k = (seconds / seeded <= last ? 2 * k : std::max(1, k / 2));
+         last = seconds / seeded;
+      }
+   }
+};
+
+struct vertex_set {
+   // dense positions plus a compact member list, so membership, insert and erase (swap with the last member) are O(1)
+   std::vector<int> members, position;
+   int first;
+
+   vertex_set(int n, int f = 0)
+   : position(n, -1), first(f) {
+   }
+   void insert(int v) {
+      if (position[v - first] == -1) {
+         position[v - first] = members.size( );
+         members.push_back(v);
+      }
+   }
+   void erase(int v) {
+      if (int p = position[v - first]; p != -1) {
+         position[members.back( ) - first] = p;
+         members[p] = members.back( );
+         members.pop_back( );
+         position[v - first] = -1;
+      }
+   }
+   bool contains(int v) const {
+      return position[v - first] != -1;
+   }
+   void merge(vertex_set& other) {
+      for (int v : other.members) {
+         insert(v);
+      }
+      other.clear( );
+   }
+   void clear( ) {
+      for (int v : members) {
+         position[v - first] = -1;
+      }
+      members.clear( );
+   }
+   std::vector<int>::const_iterator begin( ) const {
+      return members.begin( );
+   }
+   std::vector<int>::const_iterator end( ) const {
+      return members.end( );
+   }
+   int size( ) const {
+      return members.size( );
+   }
+   bool empty( ) const {
+      return members.empty( );
+   }
+};
 
 void update_matching(std::vector<int>& matching, std::vector<int>& tree, int start, int a, int b) {
-   std::vector<std::pair<int, int>> path;
+   static std::vector<std::pair<int, int>> path;      // scratch reused by every phase
+   path.clear( );
    for (int p = start; tree[p] != -1; p = tree[p]) {
       path.emplace_back(p, tree[p]);
    }
@@ -74,31 +224,106 @@ void update_matching(std::vector<int>& matching, std::vector<int>& tree, int sta
 struct mapping {
    const std::vector<point>& points;
    const std::vector<double>& weight;
-   std::map<point, int> indices;
+   std::multimap<point, int> indices;
+   std::vector<std::uint64_t> order;
 
    mapping(const std::vector<point>& p, const std::vector<double>& w)
-   : points(p), weight(w) {
+   : points(p), weight(w), order(p.size( )) {
       for (int v = 0; v < points.size( ); ++v) {
          indices.emplace(points[v], v);
       }
+
+      // position of every point along a Hilbert curve over the bounding box
+      auto [min_x, max_x] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [min_y, max_y] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      double side = std::max({ max_x->x - min_x->x, max_y->y - min_y->y, 1e-9 });
+      for (int v = 0; v < points.size( ); ++v) {
+         order[v] = hilbert_index((points[v].x - min_x->x) / side * 65535, (points[v].y - min_y->y) / side * 65535);
+      }
    }
 };
 
 struct voronoi_diagram {
+   static inline double construction = 0;      // seconds spent in bulk_insert over the whole run
    Apollonius_graph diagrama;
+   std::map<int, double> sites;
 
    voronoi_diagram( ) = default;
-   voronoi_diagram(const std::set<int>& set, const mapping& m) {
+   voronoi_diagram(const std::vector<int>& set, const mapping& m) {
       insert(set, m);
    }
-   void insert(const std::set<int>& set, const mapping& m) {
+   void insert(const std::vector<int>& set, const mapping& m) {
+      std::vector<std::pair<int, double>> batch;
       for (int v : set) {
-         diagrama.insert({ { m.points[v].x, m.points[v].y }, m.weight[v] });
+         sites.emplace(v, m.weight[v]);
+         batch.emplace_back(v, m.weight[v]);
+      }
+      bulk_insert(std::move(batch), m);
+   }
+   void bulk_insert(std::vector<std::pair<int, double>> batch, const mapping& m) {
+      auto start = std::chrono::steady_clock::now( );
+      // Hilbert order keeps consecutive sites close, so each point location starts from the previous vertex
+      std::sort(batch.begin( ), batch.end( ), [&](auto elem1, auto elem2) {
+         return m.order[elem1.first] < m.order[elem2.first];
+      });
+      Apollonius_graph::Vertex_handle hint;
+      for (auto [v, w] : batch) {
+         Apollonius_graph::Site_2 site({ m.points[v].x, m.points[v].y }, w);
+         auto vertex = (hint == Apollonius_graph::Vertex_handle( ) ? diagrama.insert(site) : diagrama.insert(site, hint));
+         if (vertex != Apollonius_graph::Vertex_handle( )) {
+            hint = vertex;
+         }
+      }
+      construction += std::chrono::duration<double>(std::chrono::steady_clock::now( ) - start).count( );
+   }
+   void insert(int v, const mapping& m) {
+      sites.emplace(v, m.weight[v]);
+      diagrama.insert({ { m.points[v].x, m.points[v].y }, m.weight[v] });
+   }
+   void erase(int v, const mapping& m) {
+      auto vertex = diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y });
+      bool visible = (index(vertex, m) == v);
+      sites.erase(v);
+      if (visible) {
+         diagrama.remove(vertex);
+      } else {
+         // hidden sites cannot be removed from an Apollonius graph, rebuild without it
+         diagrama.clear( );
+         bulk_insert({ sites.begin( ), sites.end( ) }, m);
       }
    }
    int find(int v, const mapping& m) {
-      auto res = diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y })->site( );
-      return m.indices.find(point{CGAL::to_double(res.x( )), CGAL::to_double(res.y( ))})->second;
+      return index(diagrama.nearest_neighbor({ m.points[v].x, m.points[v].y }), m);
+   }
+   std::vector<std::pair<int, int>> find(std::vector<int> queries, const mapping& m) {
+      // queries in Hilbert order, so each walk starts from the answer to the previous, nearby query
+      std::sort(queries.begin( ), queries.end( ), [&](int v1, int v2) {
+         return m.order[v1] < m.order[v2];
+      });
+      std::vector<std::pair<int, int>> res;
+      Apollonius_graph::Vertex_handle hint;
+      for (int v : queries) {
+         Apollonius_graph::Point_2 p(m.points[v].x, m.points[v].y);
+         hint = (hint == Apollonius_graph::Vertex_handle( ) ? diagrama.nearest_neighbor(p) : diagrama.nearest_neighbor(p, hint));
+         res.emplace_back(v, index(hint, m));
+      }
+      return res;
+   }
+   int index(Apollonius_graph::Vertex_handle vertex, const mapping& m) const {
+      // points may repeat, the site is the member of this diagram at its position that hides the others there
+      auto res = vertex->site( );
+      auto [from, to] = m.indices.equal_range(point{CGAL::to_double(res.x( )), CGAL::to_double(res.y( ))});
+      int best = -1;
+      for (auto it = from; it != to; ++it) {
+         if (auto site = sites.find(it->second); site != sites.end( ) && (best == -1 || site->second > sites.at(best))) {
+            best = it->second;
+         }
+      }
+      return best;
    }
    bool empty( ) const {
       return diagrama.number_of_vertices( ) == 0;
@@ -120,9 +345,20 @@ struct min_heap {
          heap.erase(handles[i].back( ));
       }
    }
+   void pop( ) {
+      auto [d, i, j] = heap.top( );
+      auto it = std::find_if(handles[i].begin( ), handles[i].end( ), [&](auto handle) {
+         return std::get<2>(*handle) == j;
+      });
+      heap.erase(*it);
+      handles[i].erase(it);
+   }
    void clear( ) {
+      // only the handle lists of queued entries are reset, their storage is kept for the next phase
+      for (auto [d, i, j] : heap) {
+         handles[i].clear( );
+      }
       heap.clear( );
-      handles = std::vector<std::vector<decltype(heap)::handle_type>>(handles.size( ));
    }
    std::tuple<double, int, int> top( ) const {
       return heap.top( );
@@ -132,7 +368,151 @@ struct min_heap {
    }
 };
 
-int main( ) try {
+std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t hash = 14695981039346656037ull) {
+   for (std::size_t c = 0; c < size; ++c) {
+      hash = (hash ^ static_cast<const unsigned char*>(data)[c]) * 1099511628211ull;
+   }
+   return hash;
+}
+
+struct checkpoint {
+   // matching, alpha, beta and the phase counter, saved at phase boundaries by --checkpoint FILE and read back by --resume FILE;
+   // the file is written by a background thread, at most once every --checkpoint-every SECONDS (10 by default) and once more
+   // when the phase loop ends, and a phase whose predecessor is still being written is not saved
+   std::string save, load;
+   std::future<void> pending;
+   std::chrono::duration<double> every{ 10 };
+   std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now( );
+
+   checkpoint(int& argc, char* argv[]) {
+      for (int c = 1; c + 1 < argc;) {
+         if (std::string flag = argv[c]; flag == "--checkpoint" || flag == "--resume") {
+            (flag == "--checkpoint" ? save : load) = argv[c + 1];
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+         } else if (flag == "--checkpoint-every") {
+            every = std::chrono::duration<double>(std::stod(argv[c + 1]));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+         } else {
+            ++c;
+         }
+      }
+   }
+   static std::uint64_t fingerprint(int a, int b, const std::vector<point>& points) {
+      std::int32_t sizes[ ] = { a, b };
+      return fnv1a(points.data( ), points.size( ) * sizeof(point), fnv1a(sizes, sizeof(sizes)));
+   }
+   static std::size_t length(int a, int b) {
+      // magic, a, b, phase, instance fingerprint, matching, alpha, beta of B, checksum
+      return 4 + 3 * sizeof(std::int32_t) + sizeof(std::uint64_t) + (a + b) * sizeof(std::int32_t) + (a + b) * sizeof(double) + sizeof(std::uint64_t);
+   }
+   void store(int a, int b, int phase, std::uint64_t instance, const std::vector<int>& matching, const std::vector<double>& alpha, const std::vector<double>& beta, bool wait = false) {
+      if (save.empty( ) || (!wait && std::chrono::steady_clock::now( ) - last < every)) {
+         return;
+      }
+      if (!wait && pending.valid( ) && pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+         return;
+      }
+      last = std::chrono::steady_clock::now( );
+      if (pending.valid( )) {
+         pending.get( );      // rethrows a failed write
+      }
+
+      std::string bytes;
+      bytes.reserve(length(a, b));
+      auto put = [&](const void* data, std::size_t size) {
+         bytes.append(static_cast<const char*>(data), size);
+      };
+      std::int32_t header[ ] = { a, b, phase };
+      put("ECCK", 4), put(header, sizeof(header)), put(&instance, sizeof(instance));
+      for (int v = 0; v < a + b; ++v) {
+         std::int32_t mate = matching[v];
+         put(&mate, sizeof(mate));
+      }
+      put(alpha.data( ), a * sizeof(double)), put(beta.data( ) + a, b * sizeof(double));
+      std::uint64_t checksum = fnv1a(bytes.data( ), bytes.size( ));
+      put(&checksum, sizeof(checksum));
+
+      pending = std::async(std::launch::async, [bytes = std::move(bytes), file = save] {
+         // written aside and renamed, so an interrupted write never replaces the last good checkpoint
+         std::ofstream out(file + ".tmp", std::ios::binary);
+         out.write(bytes.data( ), bytes.size( ));
+         out.close( );
+         if (!out || std::rename((file + ".tmp").c_str( ), file.c_str( )) != 0) {
+            throw std::runtime_error("cannot write checkpoint");
+         }
+      });
+      if (wait) {
+         pending.get( );
+      }
+   }
+   void restore(int a, int b, std::uint64_t instance, std::vector<int>& matching, std::vector<double>& alpha, std::vector<double>& beta, int& phase) const {
+      if (load.empty( )) {
+         return;
+      }
+      std::ifstream in(load, std::ios::binary);
+      std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>( ));
+      std::size_t at = 0;
+      auto get = [&](void* data, std::size_t size) {
+         std::memcpy(data, bytes.data( ) + at, size);
+         at += size;
+      };
+      if (bytes.size( ) != length(a, b) || bytes.compare(0, 4, "ECCK") != 0) {
+         throw std::runtime_error("checkpoint does not belong to this instance");
+      }
+      std::uint64_t checksum;
+      at = bytes.size( ) - sizeof(checksum), get(&checksum, sizeof(checksum));
+      if (checksum != fnv1a(bytes.data( ), bytes.size( ) - sizeof(checksum))) {
+         throw std::runtime_error("corrupt checkpoint");
+      }
+
+      std::int32_t header[3]; std::uint64_t stored;
+      at = 4, get(header, sizeof(header)), get(&stored, sizeof(stored));
+      if (header[0] != a || header[1] != b || stored != instance) {
+         throw std::runtime_error("checkpoint does not belong to this instance");
+      }
+      for (int v = 0; v < a + b; ++v) {
+         std::int32_t mate;
+         get(&mate, sizeof(mate));
+         matching[v] = mate;
+      }
+      get(alpha.data( ), a * sizeof(double)), get(beta.data( ) + a, b * sizeof(double));
+      for (int v = 0; v < a + b; ++v) {
+         if (int mate = matching[v]; mate != -1 && (mate < 0 || mate >= a + b || (mate < a) == (v < a) || matching[mate] != v)) {
+            throw std::runtime_error("checkpoint holds an invalid matching");
+         }
+      }
+      phase = header[2];
+   }
+};
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the phase loop stops on SIGTERM or after --deadline SECONDS, and the cover found so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   deadline limit(argc, argv);
+   checkpoint checkpoints(argc, argv);
+   bad_policy policy(argc, argv);
+
    int a, b;
    std::cin >> a >> b;
 
@@ -140,6 +520,7 @@ int main( ) try {
    for (int v = 0; v < a + b; ++v) {
       std::cin >> points[v].x >> points[v].y;
    }
+   bool swapped = orient(a, b, points);
 
    std::vector<int> closest_v(a + b);
    std::vector<double> nearest(a + b, std::numeric_limits<double>::max( ));
@@ -165,40 +546,86 @@ int main( ) try {
          beta[j] = std::max(beta[j], reduced_cost(i, j, points, nearest));
       }
    }
+   std::uint64_t instance = checkpoint::fingerprint(a, b, points);
+   checkpoints.restore(a, b, instance, matching, alpha, beta, policy.phase);
 
    int h = std::ceil(std::sqrt(a));
-   for (std::set<int> s1, s2; !(s1 = find_bads(a, b, matching, beta)).empty( ); s2.clear( )) {
-      int ej = *std::min_element(s1.begin( ), s1.end( ), [&](int j1, int j2) {
-         return beta[j1] < beta[j2];
-      }); double epsilon = beta[ej];
-      std::set<int> t; std::vector<std::set<int>> fi(h); int f_tam = a;
-      for (int i = 0; i < a; ++i) {
-         fi[i / h].insert(i);
-      }
-      std::vector<int> tree(a + b, -1);
+   std::vector<vertex_set> fi;
+   for (int hi = 0; hi < h; ++hi) {
+      fi.emplace_back(h, hi * h);
+   }
+   for (int i = 0; i < a; ++i) {
+      fi[i / h].insert(i);
+   }
 
-      std::vector<double> weight(a + b);
-      for (int i = 0; i < a; ++i) {
-         weight[i] = nearest[i] - alpha[i];
+   std::vector<double> weight(a + b);
+   for (int i = 0; i < a; ++i) {
+      weight[i] = nearest[i] - alpha[i];
+   }
+   for (int j = a; j < a + b; ++j) {
+      weight[j] = nearest[j] - beta[j];
+   }
+
+   mapping m(points, weight);
+   std::vector<voronoi_diagram> voronoi_fi(h);
+   for (int hi = 0; hi < h; ++hi) {
+      voronoi_fi[hi] = voronoi_diagram(fi[hi].members, m);
+   }
+
+   // scratch that outlives the phases, each phase resets only what it touched
+   vertex_set s1(a + b), s2(a + b), t(a);
+   std::vector<int> tree(a + b, -1), root(a + b, -1);
+   std::vector<std::vector<int>> branch(a + b);
+   std::vector<bool> dead(a + b, false);
+   min_heap heap_f_s1(a, b), heap_s2_f(a, b);
+
+   bad_queue bads(a, b, matching, beta);
+   for (std::vector<int> seeds; !limit.expired( ) && !(seeds = policy.next(bads, points)).empty( ); s1.clear( ), s2.clear( ), t.clear( )) {
+      auto start = std::chrono::steady_clock::now( ); int seeded = seeds.size( );
+      for (int j : seeds) {
+         s1.insert(j);
       }
-      for (int j = a; j < a + b; ++j) {
-         weight[j] = nearest[j] - beta[j];
+      int ej = *std::min_element(s1.begin( ), s1.end( ), [&](int j1, int j2) {
+         return beta[j1] < beta[j2];
+      });
+      double epsilon = beta[ej];
+      int f_tam = a; bool augmented = false;
+      for (int j : s1) {
+         root[j] = j, dead[j] = false, branch[j].assign(1, j);
       }
       double change = 0;
 
-      mapping m(points, weight);
-      voronoi_diagram voronoi_s1(s1, m);
-      std::vector<voronoi_diagram> voronoi_fi(h);
-      for (int hi = 0; hi < h; ++hi) {
-         voronoi_fi[hi] = voronoi_diagram(fi[hi], m);
-      }
+      voronoi_diagram voronoi_s1(s1.members, m);
+      auto kill = [&](int r) {
+         dead[r] = true;
+         for (int j : branch[r]) {
+            if (s1.contains(j)) {
+               voronoi_s1.erase(j, m);
+            }
+         }
+         if (dead[root[ej]]) {
+            epsilon = std::numeric_limits<double>::max( );
+            for (auto s : { &s1, &s2 }) {
+               for (int j : *s) {
+                  if (double current = nearest[j] - weight[j] - change; !dead[root[j]] && current < epsilon) {
+                     epsilon = current, ej = j;
+                  }
+               }
+            }
+         }
+      };
 
-      min_heap heap_f_s1(a, b), heap_s2_f(a, b);
-      for (int hi = 0; hi < h; ++hi) {
-         for (int i : fi[hi]) {
-            heap_f_s1.push(i, voronoi_s1.find(i, m), m);
+      heap_f_s1.clear( ), heap_s2_f.clear( );
+      auto fill_f_s1 = [&] {
+         std::vector<int> queries;
+         for (int hi = 0; hi < h; ++hi) {
+            queries.insert(queries.end( ), fi[hi].begin( ), fi[hi].end( ));
          }
-      }
+         for (auto [i, j] : voronoi_s1.find(std::move(queries), m)) {
+            heap_f_s1.push(i, j, m);
+         }
+      };
+      fill_f_s1( );
       for (int j : s2) {
          for (int hi = 0; hi < h; ++hi) {
             heap_s2_f.push(voronoi_fi[hi].find(j, m), j, m);
@@ -206,40 +633,67 @@ int main( ) try {
       }
 
       for (;;) {
-         double delta = std::numeric_limits<double>::max( ); int di, dj;
+         if (limit.expired( )) {
+            // the trees alive at the deadline are dropped as they stand, their duals are feasible already
+            break;
+         }
+
+         double delta = std::numeric_limits<double>::max( ); int di, dj; min_heap* dheap = nullptr;
          for (auto heap : { &heap_f_s1, &heap_s2_f }) {
             if (!heap->empty( )) {
                if (auto [d, i, j] = heap->top( ); delta > d) {
-                  delta = d, di = i, dj = j;
+                  delta = d, di = i, dj = j, dheap = heap;
                }
             }
          }
+         if (dheap != nullptr && dead[root[dj]]) {
+            dheap->pop( );
+            if (dheap == &heap_f_s1 && !voronoi_s1.empty( )) {
+               heap_f_s1.push(di, voronoi_s1.find(di, m), m);
+            }
+            continue;
+         }
          delta -= change;
 
-         // case 1
-         if (std::abs(delta) <= 1e-15 && matching[di] == -1) {
+         // no tight augmenting path left at the current duals
+         if (augmented && std::min(delta, epsilon) > 1e-15) {
+            break;
+         }
+
+         // case 1, a slack rounded below zero counts as tight
+         if (delta <= 1e-15 && matching[di] == -1) {
             tree[di] = dj;
             fi[di / h].erase(di), t.insert(di), f_tam -= 1;
             weight[di] += change;
+            voronoi_fi[di / h].erase(di, m);
             update_matching(matching, tree, di, a, b);
-            break;
+            kill(root[dj]), augmented = true;
+
+            heap_f_s1.erase(di), heap_s2_f.erase(di);
+            for (int j : s2) {
+               if (!voronoi_fi[di / h].empty( ) && !dead[root[j]]) {
+                  heap_s2_f.push(voronoi_fi[di / h].find(j, m), j, m);
+               }
+            }
+            continue;
          }
 
          // case 2
-         if (std::abs(delta) <= 1e-15 && matching[di] != -1) {
+         if (delta <= 1e-15 && matching[di] != -1) {
             int kj = matching[di];
             tree[kj] = di, tree[di] = dj;
+            root[kj] = root[di] = root[dj], branch[root[kj]].push_back(kj);
             fi[di / h].erase(di), t.insert(di), s2.insert(kj), f_tam -= 1;
             weight[di] += change, weight[kj] -= change;
             if (beta[kj] < epsilon) {
                epsilon = beta[kj], ej = kj;
             }
 
-            voronoi_fi[di / h] = voronoi_diagram(fi[di / h], m);
+            voronoi_fi[di / h].erase(di, m);
             if (s2.size( ) <= h) {
                heap_f_s1.erase(di), heap_s2_f.erase(di);
                for (int j : s2) {
-                  if (!voronoi_fi[di / h].empty( )) {
+                  if (!voronoi_fi[di / h].empty( ) && !dead[root[j]]) {
                      heap_s2_f.push(voronoi_fi[di / h].find(j, m), j, m);
                   }
                }
@@ -249,13 +703,15 @@ int main( ) try {
                   }
                }
             } else {
-               voronoi_s1.insert(s2, m);
-               s1.merge(std::move(s2));
+               std::vector<int> alive;
+               std::copy_if(s2.begin( ), s2.end( ), std::back_inserter(alive), [&](int j) {
+                  return !dead[root[j]];
+               });
+               voronoi_s1.insert(alive, m);
+               s1.merge(s2);
                heap_f_s1.clear( ), heap_s2_f.clear( );
-               for (int hi = 0; hi < h; ++hi) {
-                  for (int i : fi[hi]) {
-                     heap_f_s1.push(i, voronoi_s1.find(i, m), m);
-                  }
+               if (!voronoi_s1.empty( )) {
+                  fill_f_s1( );
                }
             }
             continue;
@@ -273,19 +729,32 @@ int main( ) try {
             change += epsilon;
             epsilon -= epsilon;
             update_matching(matching, tree, ej, a, b);
-            break;
+            kill(root[ej]), augmented = true;
+            continue;
          }
       }
 
       for (int i : t) {
-         alpha[i] = nearest[i] - weight[i] + change;
+         weight[i] -= change;
+         alpha[i] = nearest[i] - weight[i];
+         fi[i / h].insert(i), voronoi_fi[i / h].insert(i, m);
       }
-      for (const auto& s : { s1, s2 }) {
-         for (int j : s) {
-            beta[j] = nearest[j] - weight[j] - change;
+      for (auto s : { &s1, &s2 }) {
+         for (int j : *s) {
+            weight[j] += change;
+            beta[j] = nearest[j] - weight[j];
+            tree[j] = -1;
+            bads.update(j, matching, beta);
          }
       }
+
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+      policy.report(seeded, s1.size( ) + s2.size( ) + t.size( ), elapsed.count( ));
+      checkpoints.store(a, b, policy.phase, instance, matching, alpha, beta);
    }
+   checkpoints.store(a, b, policy.phase, instance, matching, alpha, beta, true);
+
+   std::cerr << "diagram construction " << voronoi_diagram::construction << " s\n";
 
    std::vector<edge> used;
    std::vector<bool> covered(a + b, false);
@@ -302,9 +771,23 @@ int main( ) try {
 
    std::cout << used.size( ) << "\n";
    for (auto [p1, p2] : used) {
-      std::cout << p1 << " " << p2 << "\n";
+      std::cout << original(p1, a, b, swapped) << " " << original(p2, a, b, swapped) << "\n";
    }
    std::cout << std::setprecision(9) << std::fixed << total << "\n";
+   if (!bads.queue.empty( )) {
+      // stopped early: the matching is not maximum, but the duals are feasible and bound the optimum from below
+      double bound = 0;
+      for (int v = 0; v < a + b; ++v) {
+         bound += nearest[v];
+      }
+      for (int i = 0; i < a; ++i) {
+         bound -= alpha[i];
+      }
+      for (int j = a; j < a + b; ++j) {
+         bound -= beta[j];
+      }
+      std::cout << "incomplete " << bound << " " << bads.queue.size( ) << "\n";
+   }
 } catch (const std::exception& ex) {
    return -1;
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+struct edge {
+   int p1, p2;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   int closest(const point& p, const std::vector<point>& points) const {
+      // ties go to the lowest index, as with a linear scan
+      int best = -1; double d = std::numeric_limits<double>::max( );
+      for (int r = 0; r <= std::max(w, h) && (best == -1 || d > (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            if (double current = distance(p, points[v]); current < d || (current == d && v < best)) {
+               d = current, best = v;
+            }
+         });
+      }
+      return best;
+   }
+};
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: no new order is started after SIGTERM or --deadline SECONDS, and the best one finished is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+std::uint64_t hilbert(std::uint32_t x, std::uint32_t y) {
+   // the position of (x, y) along the Hilbert curve through a 2^16 by 2^16 grid
+   constexpr std::uint32_t n = 1u << 16;
+   std::uint64_t d = 0;
+   for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+      std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+      d += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+         if (rx == 1) {
+            x = n - 1 - x, y = n - 1 - y;
+         }
+         std::swap(x, y);
+      }
+   }
+   return d;
+}
+
+int main(int argc, char* argv[]) try {
+   // argv[1] is the number of threads and argv[2] the number of orders tried: the fixed ones below, then random
+   // permutations; with --deadline SECONDS the orders not started by then are skipped
+   deadline limit(argc, argv);
+   auto start = std::chrono::steady_clock::now( );
+   int threads = (argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency( )));
+   int orders = (argc > 2 ? std::stoi(argv[2]) : 64);
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      std::cin >> points[i].x >> points[i].y;
+   }
+
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<int> nearest(a + b);
+   std::vector<double> length(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      nearest[i] = (i < a ? grid_b : grid_a).closest(points[i], points);
+      length[i] = distance(points[i], points[nearest[i]]);
+   }
+
+   auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+      return p1.x < p2.x;
+   });
+   auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+      return p1.y < p2.y;
+   });
+   double scale = std::max({ x2->x - x1->x, y2->y - y1->y, 1e-300 });
+   std::vector<std::uint64_t> curve(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      curve[i] = hilbert((points[i].x - x1->x) / scale * 65535, (points[i].y - y1->y) / scale * 65535);
+   }
+
+   // the first two orders are those of heuristic_bestoftwo, so the cover is never worse than its; far points go first in descending
+   // nearest, as they take an edge of their own in every order anyway
+   const std::vector<std::string> fixed = { "index", "reverse index", "hilbert", "reverse hilbert", "descending nearest", "x sweep", "reverse x sweep", "y sweep", "reverse y sweep", "x + y sweep", "x - y sweep" };
+   auto name = [&](int k) {
+      return (k < fixed.size( ) ? fixed[k] : "random " + std::to_string(k - fixed.size( )));
+   };
+   auto order = [&](int k) {
+      std::vector<int> res(a + b);
+      std::iota(res.begin( ), res.end( ), 0);
+      auto by = [&](auto key) {
+         std::stable_sort(res.begin( ), res.end( ), [&](int v1, int v2) {
+            return key(v1) < key(v2);
+         });
+      };
+      if (k == 2 || k == 3) {
+         by([&](int v) {
+            return curve[v];
+         });
+      } else if (k == 4) {
+         by([&](int v) {
+            return -length[v];
+         });
+      } else if (k == 5 || k == 6) {
+         by([&](int v) {
+            return points[v].x;
+         });
+      } else if (k == 7 || k == 8) {
+         by([&](int v) {
+            return points[v].y;
+         });
+      } else if (k == 9) {
+         by([&](int v) {
+            return points[v].x + points[v].y;
+         });
+      } else if (k == 10) {
+         by([&](int v) {
+            return points[v].x - points[v].y;
+         });
+      } else if (k >= fixed.size( )) {
+         std::shuffle(res.begin( ), res.end( ), std::mt19937(k));
+      }
+      if (k == 1 || k == 3 || k == 6 || k == 8) {
+         std::reverse(res.begin( ), res.end( ));
+      }
+      return res;
+   };
+
+   // every worker owns a covered bitset and takes the next order until all are tried or time is up; only totals are kept,
+   // the winning order is replayed at the end
+   std::vector<double> totals(orders, std::numeric_limits<double>::max( ));
+   std::atomic<int> next = 0;
+   std::vector<std::thread> workers;
+   for (int w = 0; w < threads; ++w) {
+      workers.emplace_back([&] {
+         std::vector<bool> covered(a + b);
+         for (int k; (k = next++) < orders && (k == 0 || !limit.expired( ));) {
+            std::fill(covered.begin( ), covered.end( ), false);
+            double total = 0;
+            for (int i : order(k)) {
+               if (!covered[i]) {
+                  covered[i] = covered[nearest[i]] = true;
+                  total += length[i];
+               }
+            }
+            totals[k] = total;
+         }
+      });
+   }
+   for (auto& worker : workers) {
+      worker.join( );
+   }
+
+   int best = std::min_element(totals.begin( ), totals.end( )) - totals.begin( );
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+   std::cerr << std::count_if(totals.begin( ), totals.end( ), [](double total) {
+      return total != std::numeric_limits<double>::max( );
+   }) << " of " << orders << " orders in " << std::setprecision(3) << std::fixed << elapsed.count( ) << " s, best " << name(best) << "\n";
+
+   std::vector<edge> used; double total = 0;
+   std::vector<bool> covered(a + b, false);
+   for (int i : order(best)) {
+      if (!covered[i]) {
+         used.push_back(edge{i, nearest[i]});
+         covered[i] = true;
+         covered[nearest[i]] = true;
+         total += distance(points[i], points[nearest[i]]);
+      }
+   }
+   std::cout << used.size( ) << "\n";
+   for (auto current : used) {
+      std::cout << current.p1 << " " << current.p2 << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
@@ -2,7 +2,9 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <queue>
 #include <set>
+#include <tuple>
 #include <vector>
 
 struct point {
@@ -42,6 +44,103 @@ bool is_leaf(int p, const std::vector<std::set<int>>& adjacency) {
    return adjacency[p].size( ) == 1 && adjacency[*adjacency[p].begin( )].size( ) >= 2;
 }
 
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   std::vector<int> closest(const point& p, int k, const std::vector<point>& points) const {
+      // the k closest points by squared distance and then index, so a longer query extends a shorter one
+      std::vector<std::pair<double, int>> found;
+      for (int r = 0; r <= std::max(w, h) && (found.size( ) < k || r <= 1 || found[k - 1].first >= (r - 1) * size * (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            found.emplace_back(distance_magnitude(p, points[v]), v);
+         });
+         if (found.size( ) >= k) {
+            std::nth_element(found.begin( ), found.begin( ) + (k - 1), found.end( ));
+            found.resize(k);
+         }
+      }
+      std::sort(found.begin( ), found.end( ));
+      std::vector<int> res;
+      for (auto [d, v] : found) {
+         res.push_back(v);
+      }
+      return res;
+   }
+};
+
+struct edge_stream {
+   // the edges between A and B by increasing squared length and then ends, as the full sorted list would give them;
+   // every point of A walks its closest points of B, fetched from the grid and four times as many whenever they run out
+   const std::vector<point>& points;
+   int a, b;
+   grid grid_b;
+   std::vector<std::vector<int>> close;
+   std::vector<int> next;
+   std::priority_queue<std::tuple<double, int, int>, std::vector<std::tuple<double, int, int>>, std::greater<>> heap;
+
+   edge_stream(const std::vector<point>& points, int a, int b)
+   : points(points), a(a), b(b), grid_b(points, a, a + b), close(a), next(a, 0) {
+      for (int i = 0; i < a; ++i) {
+         advance(i);
+      }
+   }
+   void advance(int i) {
+      if (next[i] == close[i].size( )) {
+         if (close[i].size( ) == b) {
+            return;
+         }
+         close[i] = grid_b.closest(points[i], std::max<int>(8, 4 * close[i].size( )), points);
+      }
+      int j = close[i][next[i]++];
+      heap.emplace(distance_magnitude(points[i], points[j]), i, j);
+   }
+   bool pop(edge& current) {
+      if (heap.empty( )) {
+         return false;
+      }
+      auto [magnitude, i, j] = heap.top( );
+      heap.pop( );
+      advance(i);
+      current = edge{ i, j };
+      return true;
+   }
+};
+
 int main( ) try {
    int a, b;
    std::cin >> a >> b;
@@ -51,18 +150,19 @@ int main( ) try {
       std::cin >> points[i].x >> points[i].y;
    }
 
-   std::vector<edge> edges;
-   for (int i = 0; i < a; ++i) {
-      for (int j = a; j < a + b; ++j) {
-         edges.push_back(edge{i, j});
-      }
-   }
-   std::sort(edges.begin( ), edges.end( ), [&](const edge& a1, const edge& a2) {
-      return distance_magnitude(points[a1.p1], points[a1.p2]) < distance_magnitude(points[a2.p1], points[a2.p2]);
-   });
+   // once every point is covered an edge is only taken when shorter than the two edges it replaces at its ends together,
+   // so the stream stops at twice the longest edge ever taken
+   edge_stream edges(points, a, b);
+   int covered = 0;
+   double longest = 0;
 
    std::vector<std::set<int>> adjacency(a + b);
-   for (auto [p1, p2] : edges) {
+   for (edge current; edges.pop(current);) {
+      auto [p1, p2] = current;
+      if (covered == a + b && distance(points[p1], points[p2]) >= 2 * longest) {
+         break;
+      }
+      bool isolated1 = is_isolated(p1, adjacency), isolated2 = is_isolated(p2, adjacency);
       auto accept_edge = [&]( )->std::pair<bool, std::vector<edge>> {
          auto detect_case = [&](auto c1, auto c2) {
             return (c1(p1, adjacency) && c2(p2, adjacency) || (std::swap(p1, p2), c1(p1, adjacency) && c2(p2, adjacency)));
@@ -103,7 +203,9 @@ int main( ) try {
          }
          adjacency[p1].insert(p2);
          adjacency[p2].insert(p1);
+         longest = std::max(longest, distance(points[p1], points[p2]));
       }
+      covered += (isolated1 && !is_isolated(current.p1, adjacency)) + (isolated2 && !is_isolated(current.p2, adjacency));
    }
 
    int used = 0;
@@ -1,8 +1,11 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <queue>
 #include <set>
+#include <tuple>
 #include <vector>
 
 struct point {
@@ -22,26 +25,187 @@ double distance(const point& p1, const point& p2) {
    return std::sqrt(distance_magnitude(p1, p2));
 }
 
-bool connected(int p1, int p2, const std::vector<std::set<int>>& adjacency) {
-   return (!adjacency[p1].empty( ) && !adjacency[p2].empty( ) && (p1 == *adjacency[p2].begin( ) || p2 == *adjacency[p1].begin( ) || *adjacency[p1].begin( ) == *adjacency[p2].begin( )));
+struct stars {
+   // the cover as intrusive neighbour lists over a fixed pool of half edges, so the greedy allocates nothing: the two
+   // halves of an edge are 2e and 2e + 1, and an edge is erased by walking the list of its end of lower degree, which
+   // in a star is the leaf; a forest on n points has fewer than n edges, so the pool never runs out
+   std::vector<int> degree, head, to, next, prev;
+   int unused;
+
+   stars(int n)
+   : degree(n, 0), head(n, -1), to(2 * n), next(2 * n, -1), prev(2 * n, -1), unused(0) {
+      for (int h = 0; h + 2 < 2 * n; h += 2) {
+         next[h] = h + 2;     // unused edges are chained through their first half
+      }
+   }
+   int anchor(int p) const {
+      // the only neighbour of a point of degree 1, some neighbour otherwise
+      return to[head[p]];
+   }
+   void link(int p, int h) {
+      prev[h] = -1, next[h] = head[p];
+      if (head[p] != -1) {
+         prev[head[p]] = h;
+      }
+      head[p] = h, ++degree[p];
+   }
+   void unlink(int p, int h) {
+      (prev[h] != -1 ? next[prev[h]] : head[p]) = next[h];
+      if (next[h] != -1) {
+         prev[next[h]] = prev[h];
+      }
+      --degree[p];
+   }
+   void insert(int p1, int p2) {
+      int h = unused;
+      unused = next[h];
+      to[h] = p2, to[h + 1] = p1;
+      link(p1, h), link(p2, h + 1);
+   }
+   void erase(int p1, int p2) {
+      if (degree[p1] > degree[p2]) {
+         std::swap(p1, p2);
+      }
+      int h = head[p1];
+      while (to[h] != p2) {
+         h = next[h];
+      }
+      unlink(p1, h), unlink(p2, h ^ 1);
+      next[h & ~1] = unused, unused = h & ~1;
+   }
+   std::vector<int> neighbors(int p) const {
+      std::vector<int> res;
+      for (int h = head[p]; h != -1; h = next[h]) {
+         res.push_back(to[h]);
+      }
+      std::sort(res.begin( ), res.end( ));
+      return res;
+   }
+};
+
+struct decision {
+   // the edges a case removes from the cover and adds to it, at most two of each
+   std::array<edge, 2> append, remove;
+   int appended = 0, removed = 0;
+};
+
+bool connected(int p1, int p2, const stars& adjacency) {
+   return (adjacency.degree[p1] != 0 && adjacency.degree[p2] != 0 && (p1 == adjacency.anchor(p2) || p2 == adjacency.anchor(p1) || adjacency.anchor(p1) == adjacency.anchor(p2)));
 }
 
-bool is_isolated(int p, const std::vector<std::set<int>>& adjacency) {
-   return adjacency[p].size( ) == 0;
+bool is_isolated(int p, const stars& adjacency) {
+   return adjacency.degree[p] == 0;
 }
 
-bool is_edge(int p, const std::vector<std::set<int>>& adjacency) {
-   return adjacency[p].size( ) == 1 && adjacency[*adjacency[p].begin( )].size( ) == 1;
+bool is_edge(int p, const stars& adjacency) {
+   return adjacency.degree[p] == 1 && adjacency.degree[adjacency.anchor(p)] == 1;
 }
 
-bool is_central(int p, const std::vector<std::set<int>>& adjacency) {
-   return adjacency[p].size( ) >= 2;
+bool is_central(int p, const stars& adjacency) {
+   return adjacency.degree[p] >= 2;
 }
 
-bool is_leaf(int p, const std::vector<std::set<int>>& adjacency) {
-   return adjacency[p].size( ) == 1 && adjacency[*adjacency[p].begin( )].size( ) >= 2;
+bool is_leaf(int p, const stars& adjacency) {
+   return adjacency.degree[p] == 1 && adjacency.degree[adjacency.anchor(p)] >= 2;
 }
 
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   std::vector<int> closest(const point& p, int k, const std::vector<point>& points) const {
+      // the k closest points by squared distance and then index, so a longer query extends a shorter one
+      std::vector<std::pair<double, int>> found;
+      for (int r = 0; r <= std::max(w, h) && (found.size( ) < k || r <= 1 || found[k - 1].first >= (r - 1) * size * (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            found.emplace_back(distance_magnitude(p, points[v]), v);
+         });
+         if (found.size( ) >= k) {
+            std::nth_element(found.begin( ), found.begin( ) + (k - 1), found.end( ));
+            found.resize(k);
+         }
+      }
+      std::sort(found.begin( ), found.end( ));
+      std::vector<int> res;
+      for (auto [d, v] : found) {
+         res.push_back(v);
+      }
+      return res;
+   }
+};
+
+struct edge_stream {
+   // the edges between A and B by increasing squared length and then ends, as the full sorted list would give them;
+   // every point of A walks its closest points of B, fetched from the grid and four times as many whenever they run out
+   const std::vector<point>& points;
+   int a, b;
+   grid grid_b;
+   std::vector<std::vector<int>> close;
+   std::vector<int> next;
+   std::priority_queue<std::tuple<double, int, int>, std::vector<std::tuple<double, int, int>>, std::greater<>> heap;
+
+   edge_stream(const std::vector<point>& points, int a, int b)
+   : points(points), a(a), b(b), grid_b(points, a, a + b), close(a), next(a, 0) {
+      for (int i = 0; i < a; ++i) {
+         advance(i);
+      }
+   }
+   void advance(int i) {
+      if (next[i] == close[i].size( )) {
+         if (close[i].size( ) == b) {
+            return;
+         }
+         close[i] = grid_b.closest(points[i], std::max<int>(8, 4 * close[i].size( )), points);
+      }
+      int j = close[i][next[i]++];
+      heap.emplace(distance_magnitude(points[i], points[j]), i, j);
+   }
+   bool pop(edge& current) {
+      if (heap.empty( )) {
+         return false;
+      }
+      auto [magnitude, i, j] = heap.top( );
+      heap.pop( );
+      advance(i);
+      current = edge{ i, j };
+      return true;
+   }
+};
+
 int main( ) try {
    int a, b;
    std::cin >> a >> b;
@@ -51,52 +215,53 @@ int main( ) try {
       std::cin >> points[i].x >> points[i].y;
    }
 
-   std::vector<edge> edges;
-   for (int i = 0; i < a; ++i) {
-      for (int j = a; j < a + b; ++j) {
-         edges.push_back(edge{i, j});
-      }
-   }
-   std::sort(edges.begin( ), edges.end( ), [&](const edge& a1, const edge& a2) {
-      return distance_magnitude(points[a1.p1], points[a1.p2]) < distance_magnitude(points[a2.p1], points[a2.p2]);
-   });
+   // once every point is covered an edge is only taken when shorter than the two edges it replaces at its ends together,
+   // so the stream stops at twice the longest edge ever taken
+   edge_stream edges(points, a, b);
+   int covered = 0;
+   double longest = 0;
 
    std::vector<int> nearest(a + b, -1);
-   std::vector<std::set<int>> adjacency(a + b);
-   for (auto [p1, p2] : edges) {
+   stars adjacency(a + b);
+   for (edge current; edges.pop(current);) {
+      auto [p1, p2] = current;
+      if (covered == a + b && distance(points[p1], points[p2]) >= 2 * longest) {
+         break;
+      }
+      bool isolated1 = is_isolated(p1, adjacency), isolated2 = is_isolated(p2, adjacency);
       if (nearest[p1] == -1) {
          nearest[p1] = p2;
       }
       if (nearest[p2] == -1) {
          nearest[p2] = p1;
       }
-      auto local_decision = [&]( )->std::pair<std::vector<edge>, std::vector<edge>> {
+      auto local_decision = [&]( )->decision {
          auto detect_case = [&](auto c1, auto c2) {
             return (c1(p1, adjacency) && c2(p2, adjacency) || (std::swap(p1, p2), c1(p1, adjacency) && c2(p2, adjacency)));
          };
          if (connected(p1, p2, adjacency)) {
             return { };
          } else if (detect_case(is_isolated, is_isolated)) {
-            return { { edge(p1, p2) }, { } };
+            return { { edge(p1, p2) }, { }, 1, 0 };
          } else if (detect_case(is_isolated, is_edge)) {
-            return { { edge(p1, p2) }, { } };
+            return { { edge(p1, p2) }, { }, 1, 0 };
          } else if (detect_case(is_isolated, is_central)) {
-            return { { edge(p1, p2) }, { } };
+            return { { edge(p1, p2) }, { }, 1, 0 };
          } else if (detect_case(is_isolated, is_leaf)) {
-            return { { edge(p1, p2) }, { edge(p2, *adjacency[p2].begin( )) } };
+            return { { edge(p1, p2) }, { edge(p2, adjacency.anchor(p2)) }, 1, 1 };
          } else if (detect_case(is_edge, is_edge)) {
-            int p1x = *adjacency[p1].begin( ), p2x = *adjacency[p2].begin( );
+            int p1x = adjacency.anchor(p1), p2x = adjacency.anchor(p2);
             if (distance(points[p1], points[p2]) + distance(points[p1x], points[p2x]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
-               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) } };
+               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) }, 2, 2 };
             } else {
                return { };
             }
          } else if (detect_case(is_edge, is_central)) {
             return { };
          } else if (detect_case(is_edge, is_leaf)) {
-            int p1x = *adjacency[p1].begin( ), p2x = *adjacency[p2].begin( );
+            int p1x = adjacency.anchor(p1), p2x = adjacency.anchor(p2);
             if (distance(points[p1], points[p2]) + distance(points[p1x], points[p2x]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
-               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) } };
+               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) }, 2, 2 };
             } else {
                return { };
             }
@@ -105,49 +270,74 @@ int main( ) try {
          } else if (detect_case(is_central, is_leaf)) {
             return { };
          } else if (detect_case(is_leaf, is_leaf)) {
-            int p1x = *adjacency[p1].begin( ), p2x = *adjacency[p2].begin( );
+            int p1x = adjacency.anchor(p1), p2x = adjacency.anchor(p2);
             if (distance(points[p1], points[p2]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
-               return { { edge(p1, p2) }, { edge(p1, p1x), edge(p2, p2x) } };
+               return { { edge(p1, p2) }, { edge(p1, p1x), edge(p2, p2x) }, 1, 2 };
             } else {
                return { };
             }
          }
       };
 
-      auto [append, remove] = local_decision( );
-      for (edge current : remove) {
-         adjacency[current.p1].erase(current.p2);
-         adjacency[current.p2].erase(current.p1);
+      decision taken = local_decision( );
+      for (int c = 0; c < taken.removed; ++c) {
+         adjacency.erase(taken.remove[c].p1, taken.remove[c].p2);
       }
-      for (edge current : append) {
-         adjacency[current.p1].insert(current.p2);
-         adjacency[current.p2].insert(current.p1);
+      for (int c = 0; c < taken.appended; ++c) {
+         adjacency.insert(taken.append[c].p1, taken.append[c].p2);
+         longest = std::max(longest, distance(points[taken.append[c].p1], points[taken.append[c].p2]));
       }
+      covered += (isolated1 && !is_isolated(current.p1, adjacency)) + (isolated2 && !is_isolated(current.p2, adjacency));
    }
 
-   bool changes = true;
-   for (int i = 0; i < a + b && changes; ++i) {
-      changes = false;
-      for (int i = 0; i < a + b; ++i) {
-         if (is_leaf(i, adjacency) && nearest[i] != *adjacency[i].begin( )) {
-            changes = true;
-            adjacency[*adjacency[i].begin( )].erase(i);
-            adjacency[i].erase(*adjacency[i].begin( ));
-            adjacency[i].insert(nearest[i]);
-            adjacency[nearest[i]].insert(i);
+   // leaves move to their nearest point in rounds over increasing indices, until a round moves nothing; a move only
+   // changes the points it touches, so a round visits the candidates in an ordered worklist, and a point that becomes a
+   // candidate behind the current one waits for the next round, exactly where a full rescan would have found it
+   auto candidate = [&](int v) {
+      return is_leaf(v, adjacency) && nearest[v] != adjacency.anchor(v);
+   };
+   std::set<int> round, later;
+   for (int v = 0; v < a + b; ++v) {
+      if (candidate(v)) {
+         round.insert(v);
+      }
+   }
+   for (int rounds = 0; rounds < a + b && !round.empty( ); ++rounds, std::swap(round, later)) {
+      while (!round.empty( )) {
+         int i = *round.begin( );
+         round.erase(round.begin( ));
+         if (!candidate(i)) {
+            continue;
+         }
+         int center = adjacency.anchor(i);
+         adjacency.erase(i, center);
+         adjacency.insert(i, nearest[i]);
+
+         // a center left with one neighbour becomes a leaf of it, and the partner of a point that turns into a center
+         // becomes its leaf; no other point changes whether it is a candidate
+         int touched[] = { center, adjacency.degree[center] == 1 ? adjacency.anchor(center) : -1, nearest[i], -1 };
+         if (adjacency.degree[nearest[i]] == 2) {
+            for (int h = adjacency.head[nearest[i]]; h != -1; h = adjacency.next[h]) {
+               touched[3] = (adjacency.to[h] != i ? adjacency.to[h] : touched[3]);
+            }
+         }
+         for (int v : touched) {
+            if (v != -1 && candidate(v)) {
+               (v > i ? round : later).insert(v);
+            }
          }
       }
    }
 
    int used = 0;
    for (int i = 0; i < a; ++i) {
-      used += adjacency[i].size( );
+      used += adjacency.degree[i];
    }
    std::cout << used << "\n";
 
    double total = 0;
    for (int i = 0; i < a; ++i) {
-      for (int neighbor : adjacency[i]) {
+      for (int neighbor : adjacency.neighbors(i)) {
          std::cout << i << " " << neighbor << "\n";
          total += distance(points[i], points[neighbor]);
       }
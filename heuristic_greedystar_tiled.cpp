@@ -0,0 +1,409 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+struct edge {
+   int p1, p2;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+bool connected(int p1, int p2, const std::vector<std::set<int>>& adjacency) {
+   return (!adjacency[p1].empty( ) && !adjacency[p2].empty( ) && (p1 == *adjacency[p2].begin( ) || p2 == *adjacency[p1].begin( ) || *adjacency[p1].begin( ) == *adjacency[p2].begin( )));
+}
+
+bool is_isolated(int p, const std::vector<std::set<int>>& adjacency) {
+   return adjacency[p].size( ) == 0;
+}
+
+bool is_edge(int p, const std::vector<std::set<int>>& adjacency) {
+   return adjacency[p].size( ) == 1 && adjacency[*adjacency[p].begin( )].size( ) == 1;
+}
+
+bool is_central(int p, const std::vector<std::set<int>>& adjacency) {
+   return adjacency[p].size( ) >= 2;
+}
+
+bool is_leaf(int p, const std::vector<std::set<int>>& adjacency) {
+   return adjacency[p].size( ) == 1 && adjacency[*adjacency[p].begin( )].size( ) >= 2;
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   int closest(const point& p, const std::vector<point>& points) const {
+      int best = -1; double d = std::numeric_limits<double>::max( );
+      for (int r = 0; r <= std::max(w, h) && (best == -1 || d > (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            if (double current = distance(p, points[v]); current < d) {
+               d = current, best = v;
+            }
+         });
+      }
+      return best;
+   }
+   template<typename F> void within(const point& p, double radius, F visit) const {
+      for (int r = 0; r <= std::max(w, h) && (r - 1) * size <= radius; ++r) {
+         ring(p, r, visit);
+      }
+   }
+};
+
+void greedy(std::vector<edge>& edges, const std::vector<point>& points, std::vector<std::set<int>>& adjacency) {
+   // the construction of heuristic_greedystar_improved over the given edges, starting from the stars already in adjacency
+   // sorted on lengths taken once per edge, the repair can hand over millions of them
+   std::vector<std::pair<double, int>> keys(edges.size( ));
+   for (int c = 0; c < edges.size( ); ++c) {
+      keys[c] = { distance_magnitude(points[edges[c].p1], points[edges[c].p2]), c };
+   }
+   std::sort(keys.begin( ), keys.end( ));
+   std::vector<edge> sorted;
+   sorted.reserve(edges.size( ));
+   for (auto [d, c] : keys) {
+      sorted.push_back(edges[c]);
+   }
+   edges.swap(sorted);
+   for (auto [p1, p2] : edges) {
+      auto local_decision = [&]( )->std::pair<std::vector<edge>, std::vector<edge>> {
+         auto detect_case = [&](auto c1, auto c2) {
+            return (c1(p1, adjacency) && c2(p2, adjacency) || (std::swap(p1, p2), c1(p1, adjacency) && c2(p2, adjacency)));
+         };
+         if (connected(p1, p2, adjacency)) {
+            return { };
+         } else if (detect_case(is_isolated, is_isolated)) {
+            return { { edge(p1, p2) }, { } };
+         } else if (detect_case(is_isolated, is_edge)) {
+            return { { edge(p1, p2) }, { } };
+         } else if (detect_case(is_isolated, is_central)) {
+            return { { edge(p1, p2) }, { } };
+         } else if (detect_case(is_isolated, is_leaf)) {
+            return { { edge(p1, p2) }, { edge(p2, *adjacency[p2].begin( )) } };
+         } else if (detect_case(is_edge, is_edge)) {
+            int p1x = *adjacency[p1].begin( ), p2x = *adjacency[p2].begin( );
+            if (distance(points[p1], points[p2]) + distance(points[p1x], points[p2x]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
+               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) } };
+            } else {
+               return { };
+            }
+         } else if (detect_case(is_edge, is_central)) {
+            return { };
+         } else if (detect_case(is_edge, is_leaf)) {
+            int p1x = *adjacency[p1].begin( ), p2x = *adjacency[p2].begin( );
+            if (distance(points[p1], points[p2]) + distance(points[p1x], points[p2x]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
+               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) } };
+            } else {
+               return { };
+            }
+         } else if (detect_case(is_central, is_central)) {
+            return { };
+         } else if (detect_case(is_central, is_leaf)) {
+            return { };
+         } else if (detect_case(is_leaf, is_leaf)) {
+            int p1x = *adjacency[p1].begin( ), p2x = *adjacency[p2].begin( );
+            if (distance(points[p1], points[p2]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
+               return { { edge(p1, p2) }, { edge(p1, p1x), edge(p2, p2x) } };
+            } else {
+               return { };
+            }
+         }
+      };
+
+      auto [append, remove] = local_decision( );
+      for (edge current : remove) {
+         adjacency[current.p1].erase(current.p2);
+         adjacency[current.p2].erase(current.p1);
+      }
+      for (edge current : append) {
+         adjacency[current.p1].insert(current.p2);
+         adjacency[current.p2].insert(current.p1);
+      }
+   }
+}
+
+void split(std::vector<int>::iterator from, std::vector<int>::iterator to, const std::vector<point>& points, std::vector<std::pair<int, int>>& cores, std::vector<int>::iterator base) {
+   // median cuts across the longer side of the bounding box, until every core is at most the tile size
+   constexpr int tile = 512;
+   if (to - from <= tile) {
+      cores.emplace_back(from - base, to - base);
+      return;
+   }
+   auto [x1, x2] = std::minmax_element(from, to, [&](int v1, int v2) {
+      return points[v1].x < points[v2].x;
+   });
+   auto [y1, y2] = std::minmax_element(from, to, [&](int v1, int v2) {
+      return points[v1].y < points[v2].y;
+   });
+   bool vertical = points[*x2].x - points[*x1].x >= points[*y2].y - points[*y1].y;
+   auto middle = from + (to - from) / 2;
+   std::nth_element(from, middle, to, [&](int v1, int v2) {
+      return (vertical ? points[v1].x < points[v2].x : points[v1].y < points[v2].y);
+   });
+   split(from, middle, points, cores, base);
+   split(middle, to, points, cores, base);
+}
+
+int main(int argc, char* argv[]) try {
+   int threads = (argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency( )));
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      std::cin >> points[i].x >> points[i].y;
+   }
+
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<int> nearest(a + b);
+   std::vector<double> length(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      nearest[i] = (i < a ? grid_b : grid_a).closest(points[i], points);
+      length[i] = distance(points[i], points[nearest[i]]);
+   }
+
+   // the plane is cut into cores of a few hundred points; a tile is its core plus, for every core point, the closest few
+   // points of the other side within twice its nearest distance, so the stars of core points see the edges they would take
+   // sequentially while a side concentrated far from the other does not pull whole clusters into every tile
+   auto around = [&](int v, int reach) {
+      std::vector<std::pair<double, int>> found;
+      (v < a ? grid_b : grid_a).within(points[v], 2 * length[v], [&](int u) {
+         if (double d = distance(points[v], points[u]); d <= 2 * length[v]) {
+            found.emplace_back(d, u);
+         }
+      });
+      std::partial_sort(found.begin( ), found.begin( ) + std::min<int>(reach, found.size( )), found.end( ));
+      std::vector<int> res;
+      for (int k = 0; k < std::min<int>(reach, found.size( )); ++k) {
+         res.push_back(found[k].second);
+      }
+      return res;
+   };
+   auto near = [&](int v, auto visit) {
+      (v < a ? grid_b : grid_a).within(points[v], 2 * length[v], [&](int u) {
+         if (distance(points[v], points[u]) <= 2 * length[v]) {
+            visit(u);
+         }
+      });
+   };
+   std::vector<int> order(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      order[i] = i;
+   }
+   std::vector<std::pair<int, int>> cores;
+   split(order.begin( ), order.end( ), points, cores, order.begin( ));
+   std::vector<int> owner(a + b);
+   for (int t = 0; t < cores.size( ); ++t) {
+      for (int c = cores[t].first; c < cores[t].second; ++c) {
+         owner[order[c]] = t;
+      }
+   }
+
+   std::vector<std::vector<edge>> solved(cores.size( ));
+   std::atomic<int> next = 0;
+   std::vector<std::thread> workers;
+   for (int w = 0; w < threads; ++w) {
+      workers.emplace_back([&] {
+         for (int t; (t = next++) < cores.size( );) {
+            std::vector<int> ids;
+            for (int c = cores[t].first; c < cores[t].second; ++c) {
+               ids.push_back(order[c]);
+               for (int u : around(order[c], 8)) {
+                  ids.push_back(u);
+               }
+            }
+            std::sort(ids.begin( ), ids.end( ));      // A first, as in the instance
+            ids.erase(std::unique(ids.begin( ), ids.end( )), ids.end( ));
+
+            int in_a = std::partition_point(ids.begin( ), ids.end( ), [&](int v) {
+               return v < a;
+            }) - ids.begin( );
+            std::vector<point> local(ids.size( ));
+            for (int v = 0; v < ids.size( ); ++v) {
+               local[v] = points[ids[v]];
+            }
+            std::vector<edge> edges;
+            for (int i = 0; i < in_a; ++i) {
+               for (int j = in_a; j < ids.size( ); ++j) {
+                  edges.push_back(edge{i, j});
+               }
+            }
+            std::vector<std::set<int>> adjacency(ids.size( ));
+            greedy(edges, local, adjacency);
+            for (int i = 0; i < in_a; ++i) {
+               for (int neighbor : adjacency[i]) {
+                  if (owner[ids[i]] == t || owner[ids[neighbor]] == t) {
+                     solved[t].push_back(edge{ ids[i], ids[neighbor] });
+                  }
+               }
+            }
+         }
+      });
+   }
+   for (auto& worker : workers) {
+      worker.join( );
+   }
+
+   // an edge inside one core is kept, an edge between two cores only when both of their tiles chose it
+   std::vector<edge> crossing;
+   std::vector<std::set<int>> adjacency(a + b);
+   for (int t = 0; t < cores.size( ); ++t) {
+      for (auto [p1, p2] : solved[t]) {
+         if (owner[p1] == owner[p2]) {
+            adjacency[p1].insert(p2), adjacency[p2].insert(p1);
+         } else {
+            crossing.push_back(edge{ p1, p2 });
+         }
+      }
+   }
+   std::sort(crossing.begin( ), crossing.end( ), [](const edge& e1, const edge& e2) {
+      return std::pair(e1.p1, e1.p2) < std::pair(e2.p1, e2.p2);
+   });
+   std::vector<bool> redo(a + b, false);
+   for (int c = 0; c < crossing.size( ); ++c) {
+      if (c + 1 < crossing.size( ) && crossing[c].p1 == crossing[c + 1].p1 && crossing[c].p2 == crossing[c + 1].p2) {
+         adjacency[crossing[c].p1].insert(crossing[c].p2), adjacency[crossing[c].p2].insert(crossing[c].p1);
+         ++c;
+      } else {
+         redo[crossing[c].p1] = redo[crossing[c].p2] = true;
+      }
+   }
+
+   // agreeing tiles can still join two stars through their centers, such an edge is redundant
+   for (int i = 0; i < a; ++i) {
+      for (auto it = adjacency[i].begin( ); it != adjacency[i].end( );) {
+         if (int j = *it; adjacency[i].size( ) >= 2 && adjacency[j].size( ) >= 2) {
+            adjacency[j].erase(i), it = adjacency[i].erase(it);
+         } else {
+            ++it;
+         }
+      }
+   }
+
+   // a point is repaired when the tiles disagree on one of its seam edges or it is left uncovered, and so is every point
+   // within twice its nearest distance, which the sequential construction would have weighed against it; the repaired
+   // points lose their edges, a point isolated by that joins them, and the construction runs again over all their edges up
+   // to twice their nearest distance, on top of the stars left
+   std::vector<int> seeds;
+   for (int v = 0; v < a + b; ++v) {
+      if (redo[v] || adjacency[v].empty( )) {
+         seeds.push_back(v);
+      }
+   }
+   for (int v : seeds) {
+      redo[v] = true;
+      near(v, [&](int u) {
+         redo[u] = true;
+      });
+   }
+   for (int v = 0; v < a + b; ++v) {
+      if (redo[v]) {
+         for (int u : adjacency[v]) {
+            adjacency[u].erase(v);
+         }
+         adjacency[v].clear( );
+      }
+   }
+   for (int v = 0; v < a + b; ++v) {
+      redo[v] = redo[v] || adjacency[v].empty( );
+   }
+   std::vector<edge> repair;
+   int repaired = 0;
+   for (int i = 0; i < a + b; ++i) {
+      if (redo[i]) {
+         ++repaired;
+         near(i, [&](int j) {
+            // an edge both repaired ends reach is listed once, by its lower end
+            if (i < j || !redo[j] || distance(points[i], points[j]) > 2 * length[j]) {
+               repair.push_back(edge{ std::min(i, j), std::max(i, j) });
+            }
+         });
+      }
+   }
+   greedy(repair, points, adjacency);
+
+   bool changes = true;
+   for (int i = 0; i < a + b && changes; ++i) {
+      changes = false;
+      for (int i = 0; i < a + b; ++i) {
+         if (is_leaf(i, adjacency) && nearest[i] != *adjacency[i].begin( )) {
+            changes = true;
+            adjacency[*adjacency[i].begin( )].erase(i);
+            adjacency[i].erase(*adjacency[i].begin( ));
+            adjacency[i].insert(nearest[i]);
+            adjacency[nearest[i]].insert(i);
+         }
+      }
+   }
+   std::cerr << cores.size( ) << " tiles, " << seeds.size( ) << " points disagreeing or uncovered, " << repaired << " points repaired\n";
+
+   int used = 0;
+   for (int i = 0; i < a; ++i) {
+      used += adjacency[i].size( );
+   }
+   std::cout << used << "\n";
+
+   double total = 0;
+   for (int i = 0; i < a; ++i) {
+      for (int neighbor : adjacency[i]) {
+         std::cout << i << " " << neighbor << "\n";
+         total += distance(points[i], points[neighbor]);
+      }
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
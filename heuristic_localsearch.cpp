@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   std::vector<int> closest(const point& p, int k, const std::vector<point>& points) const {
+      // the k closest points, nearest first; a ring is searched while it may still hold one of them
+      std::vector<std::pair<double, int>> found;
+      for (int r = 0; r <= std::max(w, h) && (found.size( ) < k || found[k - 1].first > (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            found.emplace_back(distance(p, points[v]), v);
+         });
+         if (found.size( ) >= k) {
+            std::nth_element(found.begin( ), found.begin( ) + (k - 1), found.end( ));
+            found.resize(k);
+         }
+      }
+      std::sort(found.begin( ), found.end( ));
+      std::vector<int> res;
+      for (auto [d, v] : found) {
+         res.push_back(v);
+      }
+      return res;
+   }
+};
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the search stops on SIGTERM or after --deadline SECONDS, and the cover reached so far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+enum kind { drop, relocate, exchange, split, merge };
+
+struct move {
+   // the cover loses the edges p-q and x-y (when their ends are given) and gains the ones its kind adds; it is only
+   // applied while none of the four points changed since the gain was computed
+   double gain;
+   kind type;
+   std::array<int, 4> v;         // p, q, x, y
+   std::array<int, 4> stamps;
+
+   bool operator<(const move& m) const {
+      return gain < m.gain;
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   // the instance may be followed by a cover in the output format, like logs/*.out, to be improved; without one the
+   // search starts from every point joined to its nearest point
+   deadline limit(argc, argv);
+   auto start = std::chrono::steady_clock::now( );
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      std::cin >> points[i].x >> points[i].y;
+   }
+
+   // candidates come from the few closest points of the other side, and the points listing v are the ones whose
+   // moves may change when v does
+   constexpr int k = 8;
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<std::vector<int>> close(a + b), listed(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      close[v] = (v < a ? grid_b : grid_a).closest(points[v], k, points);
+      for (int u : close[v]) {
+         listed[u].push_back(v);
+      }
+   }
+
+   std::vector<std::set<int>> adjacency(a + b);
+   auto join = [&](int p1, int p2) {
+      if ((p1 < a) == (p2 < a)) {
+         throw std::invalid_argument("an edge must join both sides");
+      }
+      adjacency[p1].insert(p2), adjacency[p2].insert(p1);
+   };
+   if (int used; std::cin >> used) {
+      for (int c = 0; c < used; ++c) {
+         int p1, p2;
+         std::cin >> p1 >> p2;
+         join(p1, p2);
+      }
+   } else {
+      for (int v = 0; v < a + b; ++v) {
+         join(v, close[v][0]);
+      }
+   }
+   if (std::any_of(adjacency.begin( ), adjacency.end( ), [](const std::set<int>& s) {
+      return s.empty( );
+   })) {
+      throw std::invalid_argument("not a cover");
+   }
+   auto length = [&](int p1, int p2) {
+      return distance(points[p1], points[p2]);
+   };
+   auto cost = [&] {
+      double total = 0;
+      for (int i = 0; i < a; ++i) {
+         for (int neighbor : adjacency[i]) {
+            total += length(i, neighbor);
+         }
+      }
+      return total;
+   };
+   double initial = cost( );
+
+   std::vector<int> stamp(a + b, 0);
+   std::priority_queue<move> moves;
+   auto degree = [&](int v) {
+      return int(adjacency[v].size( ));
+   };
+   auto offer = [&](double gain, kind type, int p, int q, int x, int y) {
+      if (gain > 1e-9) {
+         moves.push(move{ gain, type, { p, q, x, y }, { stamp[p], q == -1 ? 0 : stamp[q], x == -1 ? 0 : stamp[x], y == -1 ? 0 : stamp[y] } });
+      }
+   };
+   auto consider = [&](int p) {
+      // every move in which p is the first point, found in O(k) through the candidates of p
+      if (degree(p) >= 2) {
+         for (int q : adjacency[p]) {
+            if (degree(q) >= 2) {
+               offer(length(p, q), drop, p, q, -1, -1);       // an edge between two centers is redundant
+            }
+         }
+         return;
+      }
+      int q = *adjacency[p].begin( );
+      for (int x : close[p]) {
+         if (x == q) {
+            continue;
+         }
+         if (degree(q) >= 2) {
+            offer(length(p, q) - length(p, x), relocate, p, q, x, -1);       // the leaf p changes its center
+         }
+         if (degree(x) == 1) {
+            int y = *adjacency[x].begin( );
+            if (degree(q) >= 2 && degree(y) >= 2) {
+               offer(length(p, q) + length(x, y) - length(p, x), split, p, q, x, y);      // two leaves leave their stars for an edge
+            }
+            if (!adjacency[q].contains(y)) {
+               offer(length(p, q) + length(x, y) - length(p, x) - length(q, y), exchange, p, q, x, y);      // two edges swap ends
+            }
+         }
+      }
+      if (degree(q) == 1 && p < a) {
+         // the edge p-q joins the stars around its ends
+         int x = (close[p][0] != q ? close[p][0] : close[p].size( ) > 1 ? close[p][1] : -1), y = (close[q][0] != p ? close[q][0] : close[q].size( ) > 1 ? close[q][1] : -1);
+         if (x != -1 && y != -1) {
+            offer(length(p, q) - length(p, x) - length(q, y), merge, p, q, x, y);
+         }
+      }
+   };
+   for (int v = 0; v < a + b; ++v) {
+      consider(v);
+   }
+
+   std::array<int, 5> applied = { };
+   while (!moves.empty( ) && !limit.expired( )) {
+      move m = moves.top( );
+      moves.pop( );
+      auto [p, q, x, y] = m.v;
+      bool stale = false;
+      for (int c = 0; c < 4; ++c) {
+         stale = stale || (m.v[c] != -1 && stamp[m.v[c]] != m.stamps[c]);
+      }
+      if (stale) {
+         continue;
+      }
+
+      auto unlink = [&](int p1, int p2) {
+         adjacency[p1].erase(p2), adjacency[p2].erase(p1);
+      };
+      std::vector<int> changed = { p, q };
+      unlink(p, q);
+      if (m.type == relocate) {
+         join(p, x), changed.push_back(x);
+      } else if (m.type == split || m.type == exchange) {
+         unlink(x, y), join(p, x), changed.insert(changed.end( ), { x, y });
+         if (m.type == exchange) {
+            join(q, y);
+         }
+      } else if (m.type == merge) {
+         join(p, x), join(q, y), changed.insert(changed.end( ), { x, y });
+      }
+      ++applied[m.type];
+
+      // the changed points, the stars around them and the points that have one of those as a candidate get new moves
+      std::set<int> around;
+      for (int v : changed) {
+         ++stamp[v];
+         around.insert(v);
+         around.insert(adjacency[v].begin( ), adjacency[v].end( ));
+      }
+      for (int v : std::vector<int>(around.begin( ), around.end( ))) {
+         around.insert(listed[v].begin( ), listed[v].end( ));
+      }
+      for (int v : around) {
+         consider(v);
+      }
+   }
+
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+   std::cerr << "cost " << std::setprecision(9) << std::fixed << initial << " -> " << cost( ) << " in " << elapsed.count( ) << " s, " << (moves.empty( ) ? "local optimum" : "stopped") << "; moves: " << applied[drop] << " drop, " << applied[relocate] << " relocate, " << applied[exchange] << " exchange, " << applied[split] << " split, " << applied[merge] << " merge\n";
+
+   int used = 0;
+   for (int i = 0; i < a; ++i) {
+      used += adjacency[i].size( );
+   }
+   std::cout << used << "\n";
+
+   double total = 0;
+   for (int i = 0; i < a; ++i) {
+      for (int neighbor : adjacency[i]) {
+         std::cout << i << " " << neighbor << "\n";
+         total += distance(points[i], points[neighbor]);
+      }
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
@@ -0,0 +1,612 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+struct edge {
+   int p1, p2;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+struct stars {
+   // the cover as intrusive neighbour lists over a fixed pool of half edges, so the greedy allocates nothing: the two
+   // halves of an edge are 2e and 2e + 1, and an edge is erased by walking the list of its end of lower degree, which
+   // in a star is the leaf; a forest on n points has fewer than n edges, so the pool never runs out
+   std::vector<int> degree, head, to, next, prev;
+   int unused;
+
+   stars(int n)
+   : degree(n, 0), head(n, -1), to(2 * n), next(2 * n, -1), prev(2 * n, -1), unused(0) {
+      for (int h = 0; h + 2 < 2 * n; h += 2) {
+         next[h] = h + 2;     // unused edges are chained through their first half
+      }
+   }
+   int anchor(int p) const {
+      // the only neighbour of a point of degree 1, some neighbour otherwise
+      return to[head[p]];
+   }
+   void link(int p, int h) {
+      prev[h] = -1, next[h] = head[p];
+      if (head[p] != -1) {
+         prev[head[p]] = h;
+      }
+      head[p] = h, ++degree[p];
+   }
+   void unlink(int p, int h) {
+      (prev[h] != -1 ? next[prev[h]] : head[p]) = next[h];
+      if (next[h] != -1) {
+         prev[next[h]] = prev[h];
+      }
+      --degree[p];
+   }
+   void insert(int p1, int p2) {
+      int h = unused;
+      unused = next[h];
+      to[h] = p2, to[h + 1] = p1;
+      link(p1, h), link(p2, h + 1);
+   }
+   void erase(int p1, int p2) {
+      if (degree[p1] > degree[p2]) {
+         std::swap(p1, p2);
+      }
+      int h = head[p1];
+      while (to[h] != p2) {
+         h = next[h];
+      }
+      unlink(p1, h), unlink(p2, h ^ 1);
+      next[h & ~1] = unused, unused = h & ~1;
+   }
+   std::vector<int> neighbors(int p) const {
+      std::vector<int> res;
+      for (int h = head[p]; h != -1; h = next[h]) {
+         res.push_back(to[h]);
+      }
+      std::sort(res.begin( ), res.end( ));
+      return res;
+   }
+};
+
+struct decision {
+   // the edges a case removes from the cover and adds to it, at most two of each
+   std::array<edge, 2> append, remove;
+   int appended = 0, removed = 0;
+};
+
+bool connected(int p1, int p2, const stars& adjacency) {
+   return (adjacency.degree[p1] != 0 && adjacency.degree[p2] != 0 && (p1 == adjacency.anchor(p2) || p2 == adjacency.anchor(p1) || adjacency.anchor(p1) == adjacency.anchor(p2)));
+}
+
+bool is_isolated(int p, const stars& adjacency) {
+   return adjacency.degree[p] == 0;
+}
+
+bool is_edge(int p, const stars& adjacency) {
+   return adjacency.degree[p] == 1 && adjacency.degree[adjacency.anchor(p)] == 1;
+}
+
+bool is_central(int p, const stars& adjacency) {
+   return adjacency.degree[p] >= 2;
+}
+
+bool is_leaf(int p, const stars& adjacency) {
+   return adjacency.degree[p] == 1 && adjacency.degree[adjacency.anchor(p)] >= 2;
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   std::vector<int> closest(const point& p, int k, const std::vector<point>& points) const {
+      // the k closest points by squared distance and then index, so a longer query extends a shorter one
+      std::vector<std::pair<double, int>> found;
+      for (int r = 0; r <= std::max(w, h) && (found.size( ) < k || r <= 1 || found[k - 1].first >= (r - 1) * size * (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            found.emplace_back(distance_magnitude(p, points[v]), v);
+         });
+         if (found.size( ) >= k) {
+            std::nth_element(found.begin( ), found.begin( ) + (k - 1), found.end( ));
+            found.resize(k);
+         }
+      }
+      std::sort(found.begin( ), found.end( ));
+      std::vector<int> res;
+      for (auto [d, v] : found) {
+         res.push_back(v);
+      }
+      return res;
+   }
+};
+
+struct edge_stream {
+   // the edges between A and B by increasing squared length and then ends, as the full sorted list would give them;
+   // every point of A walks its closest points of B, fetched from the shared grid and four times as many whenever they
+   // run out
+   const std::vector<point>& points;
+   int a, b;
+   const grid& grid_b;
+   std::vector<std::vector<int>> close;
+   std::vector<int> next;
+   std::priority_queue<std::tuple<double, int, int>, std::vector<std::tuple<double, int, int>>, std::greater<>> heap;
+
+   edge_stream(const std::vector<point>& points, int a, int b, const grid& grid_b)
+   : points(points), a(a), b(b), grid_b(grid_b), close(a), next(a, 0) {
+      for (int i = 0; i < a; ++i) {
+         advance(i);
+      }
+   }
+   void advance(int i) {
+      if (next[i] == close[i].size( )) {
+         if (close[i].size( ) == b) {
+            return;
+         }
+         close[i] = grid_b.closest(points[i], std::max<int>(8, 4 * close[i].size( )), points);
+      }
+      int j = close[i][next[i]++];
+      heap.emplace(distance_magnitude(points[i], points[j]), i, j);
+   }
+   bool pop(edge& current) {
+      if (heap.empty( )) {
+         return false;
+      }
+      auto [magnitude, i, j] = heap.top( );
+      heap.pop( );
+      advance(i);
+      current = edge{ i, j };
+      return true;
+   }
+};
+
+volatile std::sig_atomic_t interrupted = 0;
+
+struct deadline {
+   // anytime mode: the heuristics still running stop on SIGTERM or after --deadline SECONDS, and the best cover found so
+   // far is printed
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max( );
+
+   deadline(int& argc, char* argv[]) {
+      std::signal(SIGTERM, [](int) {
+         interrupted = 1;
+      });
+      for (int c = 1; c + 1 < argc; ++c) {
+         if (std::string(argv[c]) == "--deadline") {
+            end = std::chrono::steady_clock::now( ) + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::stod(argv[c + 1])));
+            std::copy(argv + c + 2, argv + argc + 1, argv + c), argc -= 2;
+            break;
+         }
+      }
+   }
+   bool expired( ) const {
+      return interrupted || std::chrono::steady_clock::now( ) >= end;
+   }
+};
+
+std::vector<edge> nearest_neighbor(std::vector<int> nearest) {
+   // heuristic_nearestneighbor: every point takes the edge to its nearest point, mutual pairs once
+   std::vector<edge> used;
+   for (int i = 0; i < nearest.size( ); ++i) {
+      if (nearest[i] != -1) {
+         used.push_back(edge{i, nearest[i]});
+         if (nearest[nearest[i]] == i) {
+            nearest[nearest[i]] = -1;
+         }
+      }
+   }
+   return used;
+}
+
+std::vector<edge> best_of_two(const std::vector<point>& points, const std::vector<int>& nearest) {
+   // heuristic_bestoftwo: uncovered points take the edge to their nearest point, in index order and in reverse
+   auto algorithm = [&](int begin, int end, int step) {
+      std::vector<edge> used; double total = 0;
+      std::vector<bool> covered(nearest.size( ), false);
+      for (int i = begin; i != end; i += step) {
+         if (!covered[i]) {
+            used.push_back(edge{i, nearest[i]});
+            covered[i] = true;
+            covered[nearest[i]] = true;
+            total += distance(points[i], points[nearest[i]]);
+         }
+      }
+      return std::pair(total, used);
+   };
+   return std::min(algorithm(0, nearest.size( ), +1), algorithm(nearest.size( ) - 1, -1, -1), [](const auto& p1, const auto& p2) {
+      return p1.first < p2.first;
+   }).second;
+}
+
+std::vector<edge> greedy_star(const std::vector<point>& points, int a, int b, const grid& grid_b, bool improved, const deadline& limit) {
+   // heuristic_greedystar, or heuristic_greedystar_improved with its edge swaps and final leaf sweep; nothing is returned
+   // when the deadline comes first
+   edge_stream edges(points, a, b, grid_b);
+   int covered = 0;
+   double longest = 0;
+
+   std::vector<int> nearest(a + b, -1);
+   stars adjacency(a + b);
+   for (edge current; edges.pop(current);) {
+      auto [p1, p2] = current;
+      if (covered == a + b && distance(points[p1], points[p2]) >= 2 * longest) {
+         break;
+      } else if (limit.expired( )) {
+         return { };
+      }
+      bool isolated1 = is_isolated(p1, adjacency), isolated2 = is_isolated(p2, adjacency);
+      if (nearest[p1] == -1) {
+         nearest[p1] = p2;
+      }
+      if (nearest[p2] == -1) {
+         nearest[p2] = p1;
+      }
+      auto local_decision = [&]( )->decision {
+         auto detect_case = [&](auto c1, auto c2) {
+            return (c1(p1, adjacency) && c2(p2, adjacency) || (std::swap(p1, p2), c1(p1, adjacency) && c2(p2, adjacency)));
+         };
+         if (connected(p1, p2, adjacency)) {
+            return { };
+         } else if (detect_case(is_isolated, is_isolated)) {
+            return { { edge(p1, p2) }, { }, 1, 0 };
+         } else if (detect_case(is_isolated, is_edge)) {
+            return { { edge(p1, p2) }, { }, 1, 0 };
+         } else if (detect_case(is_isolated, is_central)) {
+            return { { edge(p1, p2) }, { }, 1, 0 };
+         } else if (detect_case(is_isolated, is_leaf)) {
+            return { { edge(p1, p2) }, { edge(p2, adjacency.anchor(p2)) }, 1, 1 };
+         } else if (detect_case(is_edge, is_edge) || detect_case(is_edge, is_leaf)) {
+            int p1x = adjacency.anchor(p1), p2x = adjacency.anchor(p2);
+            if (improved && distance(points[p1], points[p2]) + distance(points[p1x], points[p2x]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
+               return { { edge(p1, p2), edge(p1x, p2x) }, { edge(p1, p1x), edge(p2, p2x) }, 2, 2 };
+            } else {
+               return { };
+            }
+         } else if (detect_case(is_edge, is_central)) {
+            return { };
+         } else if (detect_case(is_central, is_central)) {
+            return { };
+         } else if (detect_case(is_central, is_leaf)) {
+            return { };
+         } else if (detect_case(is_leaf, is_leaf)) {
+            int p1x = adjacency.anchor(p1), p2x = adjacency.anchor(p2);
+            if (distance(points[p1], points[p2]) < distance(points[p1], points[p1x]) + distance(points[p2], points[p2x])) {
+               return { { edge(p1, p2) }, { edge(p1, p1x), edge(p2, p2x) }, 1, 2 };
+            } else {
+               return { };
+            }
+         }
+      };
+
+      decision taken = local_decision( );
+      for (int c = 0; c < taken.removed; ++c) {
+         adjacency.erase(taken.remove[c].p1, taken.remove[c].p2);
+      }
+      for (int c = 0; c < taken.appended; ++c) {
+         adjacency.insert(taken.append[c].p1, taken.append[c].p2);
+         longest = std::max(longest, distance(points[taken.append[c].p1], points[taken.append[c].p2]));
+      }
+      covered += (isolated1 && !is_isolated(current.p1, adjacency)) + (isolated2 && !is_isolated(current.p2, adjacency));
+   }
+
+   // the worklist sweep of heuristic_greedystar_improved, leaves move to their nearest point in rounds
+   auto candidate = [&](int v) {
+      return is_leaf(v, adjacency) && nearest[v] != adjacency.anchor(v);
+   };
+   std::set<int> round, later;
+   for (int v = 0; v < a + b && improved; ++v) {
+      if (candidate(v)) {
+         round.insert(v);
+      }
+   }
+   for (int rounds = 0; rounds < a + b && !round.empty( ); ++rounds, std::swap(round, later)) {
+      while (!round.empty( )) {
+         int i = *round.begin( );
+         round.erase(round.begin( ));
+         if (!candidate(i)) {
+            continue;
+         }
+         int center = adjacency.anchor(i);
+         adjacency.erase(i, center);
+         adjacency.insert(i, nearest[i]);
+
+         int touched[] = { center, adjacency.degree[center] == 1 ? adjacency.anchor(center) : -1, nearest[i], -1 };
+         if (adjacency.degree[nearest[i]] == 2) {
+            for (int h = adjacency.head[nearest[i]]; h != -1; h = adjacency.next[h]) {
+               touched[3] = (adjacency.to[h] != i ? adjacency.to[h] : touched[3]);
+            }
+         }
+         for (int v : touched) {
+            if (v != -1 && candidate(v)) {
+               (v > i ? round : later).insert(v);
+            }
+         }
+      }
+   }
+
+   std::vector<edge> used;
+   for (int i = 0; i < a; ++i) {
+      for (int neighbor : adjacency.neighbors(i)) {
+         used.push_back(edge{ i, neighbor });
+      }
+   }
+   return used;
+}
+
+enum kind { drop, relocate, exchange, split, merge };
+
+struct move {
+   // the cover loses the edges p-q and x-y (when their ends are given) and gains the ones its kind adds; it is only
+   // applied while none of the four points changed since the gain was computed
+   double gain;
+   kind type;
+   std::array<int, 4> v;         // p, q, x, y
+   std::array<int, 4> stamps;
+
+   bool operator<(const move& m) const {
+      return gain < m.gain;
+   }
+};
+
+std::vector<edge> local_search(const std::vector<point>& points, int a, int b, const grid& grid_a, const grid& grid_b, const std::vector<edge>& cover, const deadline& limit, int& applied) {
+   // heuristic_localsearch started from the given cover, until a local optimum or the deadline
+   constexpr int k = 8;
+   std::vector<std::vector<int>> close(a + b), listed(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      close[v] = (v < a ? grid_b : grid_a).closest(points[v], k, points);
+      for (int u : close[v]) {
+         listed[u].push_back(v);
+      }
+   }
+
+   std::vector<std::set<int>> adjacency(a + b);
+   auto join = [&](int p1, int p2) {
+      adjacency[p1].insert(p2), adjacency[p2].insert(p1);
+   };
+   for (auto [p1, p2] : cover) {
+      join(p1, p2);
+   }
+   auto length = [&](int p1, int p2) {
+      return distance(points[p1], points[p2]);
+   };
+
+   std::vector<int> stamp(a + b, 0);
+   std::priority_queue<move> moves;
+   auto degree = [&](int v) {
+      return int(adjacency[v].size( ));
+   };
+   auto offer = [&](double gain, kind type, int p, int q, int x, int y) {
+      if (gain > 1e-9) {
+         moves.push(move{ gain, type, { p, q, x, y }, { stamp[p], q == -1 ? 0 : stamp[q], x == -1 ? 0 : stamp[x], y == -1 ? 0 : stamp[y] } });
+      }
+   };
+   auto consider = [&](int p) {
+      if (degree(p) >= 2) {
+         for (int q : adjacency[p]) {
+            if (degree(q) >= 2) {
+               offer(length(p, q), drop, p, q, -1, -1);
+            }
+         }
+         return;
+      }
+      int q = *adjacency[p].begin( );
+      for (int x : close[p]) {
+         if (x == q) {
+            continue;
+         }
+         if (degree(q) >= 2) {
+            offer(length(p, q) - length(p, x), relocate, p, q, x, -1);
+         }
+         if (degree(x) == 1) {
+            int y = *adjacency[x].begin( );
+            if (degree(q) >= 2 && degree(y) >= 2) {
+               offer(length(p, q) + length(x, y) - length(p, x), split, p, q, x, y);
+            }
+            if (!adjacency[q].contains(y)) {
+               offer(length(p, q) + length(x, y) - length(p, x) - length(q, y), exchange, p, q, x, y);
+            }
+         }
+      }
+      if (degree(q) == 1 && p < a) {
+         int x = (close[p][0] != q ? close[p][0] : close[p].size( ) > 1 ? close[p][1] : -1), y = (close[q][0] != p ? close[q][0] : close[q].size( ) > 1 ? close[q][1] : -1);
+         if (x != -1 && y != -1) {
+            offer(length(p, q) - length(p, x) - length(q, y), merge, p, q, x, y);
+         }
+      }
+   };
+   for (int v = 0; v < a + b; ++v) {
+      consider(v);
+   }
+
+   applied = 0;
+   while (!moves.empty( ) && !limit.expired( )) {
+      move m = moves.top( );
+      moves.pop( );
+      auto [p, q, x, y] = m.v;
+      bool stale = false;
+      for (int c = 0; c < 4; ++c) {
+         stale = stale || (m.v[c] != -1 && stamp[m.v[c]] != m.stamps[c]);
+      }
+      if (stale) {
+         continue;
+      }
+
+      auto unlink = [&](int p1, int p2) {
+         adjacency[p1].erase(p2), adjacency[p2].erase(p1);
+      };
+      std::vector<int> changed = { p, q };
+      unlink(p, q);
+      if (m.type == relocate) {
+         join(p, x), changed.push_back(x);
+      } else if (m.type == split || m.type == exchange) {
+         unlink(x, y), join(p, x), changed.insert(changed.end( ), { x, y });
+         if (m.type == exchange) {
+            join(q, y);
+         }
+      } else if (m.type == merge) {
+         join(p, x), join(q, y), changed.insert(changed.end( ), { x, y });
+      }
+      ++applied;
+
+      std::set<int> around;
+      for (int v : changed) {
+         ++stamp[v];
+         around.insert(v);
+         around.insert(adjacency[v].begin( ), adjacency[v].end( ));
+      }
+      for (int v : std::vector<int>(around.begin( ), around.end( ))) {
+         around.insert(listed[v].begin( ), listed[v].end( ));
+      }
+      for (int v : around) {
+         consider(v);
+      }
+   }
+
+   std::vector<edge> used;
+   for (int i = 0; i < a; ++i) {
+      for (int neighbor : adjacency[i]) {
+         used.push_back(edge{ i, neighbor });
+      }
+   }
+   return used;
+}
+
+int main(int argc, char* argv[]) try {
+   // argv[1] is the number of threads; the constructive heuristics share the instance, the grids and the nearest points,
+   // the best cover they give is then improved by local search, and every run and the winner are reported on stderr
+   deadline limit(argc, argv);
+   auto start = std::chrono::steady_clock::now( );
+   int threads = (argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency( )));
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      std::cin >> points[i].x >> points[i].y;
+   }
+
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<int> nearest(a + b);
+   for (int i = 0; i < a + b; ++i) {
+      nearest[i] = (i < a ? grid_b : grid_a).closest(points[i], 1, points)[0];
+   }
+   auto cost = [&](const std::vector<edge>& cover) {
+      double total = 0;
+      for (auto [p1, p2] : cover) {
+         total += distance(points[p1], points[p2]);
+      }
+      return total;
+   };
+
+   // the cheap heuristics go first, so a single thread has a cover early; a heuristic cut by the deadline gives none
+   const std::vector<std::string> names = { "heuristic_nearestneighbor", "heuristic_bestoftwo", "heuristic_greedystar", "heuristic_greedystar_improved" };
+   std::vector<std::vector<edge>> covers(names.size( ));
+   std::vector<double> seconds(names.size( ));
+   std::atomic<int> next = 0;
+   std::vector<std::thread> workers;
+   for (int w = 0; w < std::min<int>(threads, names.size( )); ++w) {
+      workers.emplace_back([&] {
+         for (int h; (h = next++) < names.size( );) {
+            auto t0 = std::chrono::steady_clock::now( );
+            if (h == 0) {
+               covers[h] = nearest_neighbor(nearest);
+            } else if (h == 1) {
+               covers[h] = best_of_two(points, nearest);
+            } else if (!limit.expired( )) {
+               covers[h] = greedy_star(points, a, b, grid_b, h == 3, limit);
+            }
+            seconds[h] = std::chrono::duration<double>(std::chrono::steady_clock::now( ) - t0).count( );
+         }
+      });
+   }
+   for (auto& worker : workers) {
+      worker.join( );
+   }
+
+   int best = 0;
+   for (int h = 0; h < names.size( ); ++h) {
+      if (covers[h].empty( )) {
+         std::cerr << names[h] << ": stopped by the deadline after " << std::setprecision(3) << std::fixed << seconds[h] << " s\n";
+      } else {
+         std::cerr << names[h] << ": cost " << std::setprecision(9) << std::fixed << cost(covers[h]) << " in " << std::setprecision(3) << seconds[h] << " s\n";
+         best = (cost(covers[h]) < cost(covers[best]) ? h : best);
+      }
+   }
+
+   std::vector<edge> used = covers[best];
+   if (!limit.expired( )) {
+      auto t0 = std::chrono::steady_clock::now( );
+      int applied;
+      used = local_search(points, a, b, grid_a, grid_b, covers[best], limit, applied);
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - t0;
+      std::cerr << "heuristic_localsearch: cost " << std::setprecision(9) << std::fixed << cost(covers[best]) << " -> " << cost(used) << " in " << std::setprecision(3) << elapsed.count( ) << " s, " << applied << " moves\n";
+   }
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+   std::cerr << "total " << std::setprecision(3) << std::fixed << elapsed.count( ) << " s\n";
+   std::cerr << "best " << names[best] << "\n";
+
+   double total = 0;
+   std::cout << used.size( ) << "\n";
+   for (auto current : used) {
+      std::cout << current.p1 << " " << current.p2 << "\n";
+      total += distance(points[current.p1], points[current.p2]);
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+struct point {
+   double x, y;
+};
+
+double distance_magnitude(const point& p1, const point& p2) {
+   double dx = p1.x - p2.x, dy = p1.y - p2.y;
+   return dx * dx + dy * dy;
+}
+
+double distance(const point& p1, const point& p2) {
+   return std::sqrt(distance_magnitude(p1, p2));
+}
+
+double reduced_cost(int p1, int p2, const std::vector<point>& points, const std::vector<double>& nearest) {
+   return nearest[p1] + nearest[p2] - distance(points[p1], points[p2]);
+}
+
+struct grid {
+   // uniform buckets of a few points each over the bounding box of all points, holding the points of one side
+   double x0, y0, size;
+   int w, h;
+   std::vector<std::vector<int>> cells;
+
+   grid(const std::vector<point>& points, int from, int to) {
+      auto [x1, x2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.x < p2.x;
+      });
+      auto [y1, y2] = std::minmax_element(points.begin( ), points.end( ), [](const point& p1, const point& p2) {
+         return p1.y < p2.y;
+      });
+      x0 = x1->x, y0 = y1->y;
+      size = std::max(x2->x - x0, y2->y - y0) / std::ceil(std::sqrt(std::max(1, to - from) / 2.0));
+      size = (size > 0 ? size : 1);
+      w = (x2->x - x0) / size + 1, h = (y2->y - y0) / size + 1;
+      cells.resize(w * h);
+      for (int v = from; v < to; ++v) {
+         cells[cell(points[v].y, y0, h) * w + cell(points[v].x, x0, w)].push_back(v);
+      }
+   }
+   int cell(double c, double c0, int n) const {
+      return std::clamp<long long>(std::floor((c - c0) / size), 0, n - 1);
+   }
+   template<typename F> void ring(const point& p, int r, F visit) const {
+      // the cells at Chebyshev distance r from the cell of p, their points are at least (r - 1) * size away
+      int cx = cell(p.x, x0, w), cy = cell(p.y, y0, h);
+      for (int y = std::max(0, cy - r); y <= std::min(h - 1, cy + r); ++y) {
+         for (int x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r || r == 0 ? 1 : 2 * r)) {
+            if (x >= 0 && x < w) {
+               for (int v : cells[y * w + x]) {
+                  visit(v);
+               }
+            }
+         }
+      }
+   }
+   int closest(const point& p, const std::vector<point>& points) const {
+      int best = -1; double d = std::numeric_limits<double>::max( );
+      for (int r = 0; r <= std::max(w, h) && (best == -1 || d > (r - 1) * size); ++r) {
+         ring(p, r, [&](int v) {
+            if (double current = distance(p, points[v]); current < d) {
+               d = current, best = v;
+            }
+         });
+      }
+      return best;
+   }
+   template<typename F> void within(const point& p, double radius, F visit) const {
+      for (int r = 0; r <= std::max(w, h) && (r - 1) * size <= radius; ++r) {
+         ring(p, r, visit);
+      }
+   }
+};
+
+int main(int argc, char* argv[]) try {
+   // argv[1] is the number of cleanup passes over the matching, 0 for the plain greedy
+   int passes = (argc > 1 ? std::stoi(argv[1]) : 4);
+   if (passes < 0) {
+      throw std::invalid_argument("passes must not be negative");
+   }
+   auto start = std::chrono::steady_clock::now( );
+
+   int a, b;
+   std::cin >> a >> b;
+
+   std::vector<point> points(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      std::cin >> points[v].x >> points[v].y;
+   }
+
+   grid grid_a(points, 0, a), grid_b(points, a, a + b);
+   std::vector<int> closest_v(a + b);
+   std::vector<double> nearest(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      closest_v[v] = (v < a ? grid_b : grid_a).closest(points[v], points);
+      nearest[v] = distance(points[v], points[closest_v[v]]);
+   }
+
+   // the edges of positive reduced cost, each found once by the end with the larger nearest distance, as it is shorter
+   // than twice that distance
+   std::vector<std::tuple<double, int, int>> candidates;
+   std::vector<std::vector<std::pair<int, double>>> edges(a + b);
+   for (int v = 0; v < a + b; ++v) {
+      (v < a ? grid_b : grid_a).within(points[v], 2 * nearest[v], [&](int u) {
+         if (double cost = reduced_cost(v, u, points, nearest); cost > 1e-15 && (nearest[v] > nearest[u] || (nearest[v] == nearest[u] && v >= a))) {
+            candidates.emplace_back(cost, std::min(u, v), std::max(u, v));
+            edges[u].emplace_back(v, cost), edges[v].emplace_back(u, cost);
+         }
+      });
+   }
+
+   // the cover is the nearest edge of every point with the matched pairs in place of the nearest edges of their ends, so
+   // it costs sum(nearest) minus the weight of the matching; the greedy takes the heaviest edge between free points
+   std::sort(candidates.begin( ), candidates.end( ), std::greater<>( ));
+   std::vector<int> matching(a + b, -1);
+   double weight = 0;
+   for (auto [cost, i, j] : candidates) {
+      if (matching[i] == -1 && matching[j] == -1) {
+         matching[i] = j, matching[j] = i;
+         weight += cost;
+      }
+   }
+   double greedy = weight;
+
+   // a pass tries every matched edge i-j against the heaviest edges from i and from j to free points, and the matching
+   // takes those instead of i-j when they weigh more together: these are the augmenting paths of length at most three
+   // through i-j, the short ones a greedy matching misses
+   auto free_best = [&](int v) {
+      std::pair<int, double> best = { -1, 0 };
+      for (auto [u, cost] : edges[v]) {
+         if (matching[u] == -1 && cost > best.second) {
+            best = { u, cost };
+         }
+      }
+      return best;
+   };
+   int pass = 0;
+   for (bool changes = true; pass < passes && changes; ++pass) {
+      changes = false;
+      for (int i = 0; i < a; ++i) {
+         if (int j = matching[i]; j != -1) {
+            auto [x, cx] = free_best(i);
+            auto [y, cy] = free_best(j);
+            if (double gain = cx + cy - reduced_cost(i, j, points, nearest); gain > 1e-12) {
+               matching[i] = x, matching[j] = y;
+               for (auto [p1, p2] : { std::pair(i, x), std::pair(j, y) }) {
+                  if (p2 != -1) {
+                     matching[p2] = p1;
+                  }
+               }
+               weight += gain;
+               changes = true;
+            }
+         }
+      }
+   }
+
+   std::vector<std::pair<int, int>> used;
+   std::vector<bool> covered(a + b, false);
+   double total = 0;
+   for (int v = 0; v < a + b; ++v) {
+      if (!covered[v]) {
+         int matched = (matching[v] != -1 ? matching[v] : closest_v[v]);
+         used.emplace_back(v, matched);
+         covered[v] = covered[matched] = true;
+         total += distance(points[v], points[matched]);
+      }
+   }
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+   std::cerr << candidates.size( ) << " edges of positive reduced cost, matching weight " << std::setprecision(9) << std::fixed << greedy << " -> " << weight << " after " << pass << " passes, " << std::setprecision(3) << elapsed.count( ) << " s\n";
+
+   std::cout << used.size( ) << "\n";
+   for (auto [p1, p2] : used) {
+      std::cout << p1 << " " << p2 << "\n";
+   }
+   std::cout << std::setprecision(9) << std::fixed << total << "\n";
+} catch (...) {
+   return -1;
+}
@@ -14,25 +14,35 @@
       'exact_subcubic_1bad_double', 
       'exact_subcubic_1bad_mpfloat', 
       'exact_subcubic_1bad_novoronoi', 
+      'exact_subcubic_1bad_spatial',
+      'exact_subcubic_1bad_logarithmic',
       'exact_subcubic_allbads_double',
       'exact_subcubic_allbads_mpfloat',
       'exact_subcubic_allbads_novoronoi',
+      'exact_parallel_1bad',
+      'exact_components',
+      'approximate_auction',
       'heuristic_nearestneighbor', 
       'heuristic_bestoftwo',
+      'heuristic_bestofk',
       'heuristic_greedystar', 
       'heuristic_greedystar_improved',
+      'heuristic_reducedcost',
+      'heuristic_greedystar_tiled',
+      'heuristic_localsearch',
+      'heuristic_portfolio',
       '_instance_generator',
       '_verifier'
    ];
    foreach ($programs as $program) {
       echo "Compiling $program...\n";
-      system("g++ -std=c++2b -O3 $program.cpp -lgurobi_c++ -lgurobi90 -Wno-return-type -o $program");
+      system("g++ -std=c++2b -O3 -pthread $program.cpp -lgurobi_c++ -lgurobi90 -Wno-return-type -o $program");
    }
    array_pop($programs); array_pop($programs);
 
    // instance generation
    foreach ([ 50, 100, 500, 1000, 2500, 5000 ] as $p) {
-      foreach ([ [ $p / 2, $p / 2 ] ] as $partition) {
+      foreach ([ [ $p / 2, $p / 2 ], [ intdiv($p, 11), $p - intdiv($p, 11) ], [ $p - intdiv($p, 11), intdiv($p, 11) ] ] as $partition) {     // balanced, 1:10 and 10:1
          list($a, $b) = $partition;
          foreach ([ 'R', 'P', 'E' ] as $c) {
             foreach ([ 0 ] as $s) {
@@ -56,10 +66,12 @@
       foreach ($programs as $program) {         
          echo "   $program", str_pad('', $padding - strlen($program) + 3, '.'), ' ';
          $t0 = microtime(true);
-         system("timeout {$limit}s ./{$program} < instances/{$instance}.in > logs/{$instance}_{$program}.out", $status);
+         system("timeout --preserve-status -k 60s {$limit}s ./{$program} < instances/{$instance}.in > logs/{$instance}_{$program}.out 2> logs/{$instance}_{$program}.err", $status);     // per-phase reports go to .err
          $t1 = microtime(true);
          $time = $t1 - $t0;
-         if ($time >= $limit || $status != 0) {
+         $temp = (file_exists("logs/{$instance}_{$program}.out") ? file("logs/{$instance}_{$program}.out", FILE_IGNORE_NEW_LINES|FILE_SKIP_EMPTY_LINES) : [ ]);
+         $incomplete = (count($temp) > 0 && strncmp(end($temp), 'incomplete', 10) == 0);    // exact solvers print their cover so far on the SIGTERM of timeout
+         if (!$incomplete && ($time >= $limit || $status != 0)) {
             echo ($time >= $limit ? 'TLE' : 'RTE'), "\n";
             unlink("logs/{$instance}_{$program}.out");
             continue;
@@ -67,10 +79,20 @@
             echo "WA\n";
             continue;
          }
-         $temp = file("logs/{$instance}_{$program}.out", FILE_IGNORE_NEW_LINES|FILE_SKIP_EMPTY_LINES);
+         $anytime = ($incomplete ? explode(' ', array_pop($temp)) : null);
          $results[$program] = (float)end($temp);
          $ratio = ($results['exact_gurobi'] == 0 ? 1 : $results[$program] / $results['exact_gurobi']);
-         printf("%7.4f seconds, value %9.4f (%.4f)\n", $t1 - $t0, $results[$program], $ratio);
+         printf("%7.4f seconds, value %9.4f (%.4f)", $t1 - $t0, $results[$program], $ratio);
+         if ($incomplete) {
+            printf(", stopped with %d bads left, lower bound %9.4f", $anytime[2], $anytime[1]);
+         }
+         foreach (file("logs/{$instance}_{$program}.err", FILE_IGNORE_NEW_LINES) as $line) {
+            // a certified ratio must hold against the optimum, 251_251_O_0 has an outlier pair that once broke it
+            if (sscanf($line, 'certified ratio %f', $certified) == 1 && $ratio > $certified + 1e-9) {
+               printf(", CERTIFICATE %.4f DOES NOT HOLD", $certified);
+            }
+         }
+         echo "\n";
          $worst[$program] = max($worst[$program], $ratio);
       }
    }
@@ -81,6 +103,20 @@
       echo "   $program", str_pad('', $padding - strlen($program)), ' ';
       printf("%.4f\n", $worst[$program]);
    }
+
+   // the portfolio names its winning heuristic on stderr, the ones that never win are not worth running
+   $wins = array_fill_keys([ 'heuristic_nearestneighbor', 'heuristic_bestoftwo', 'heuristic_greedystar', 'heuristic_greedystar_improved' ], 0);
+   foreach ($instances as $instance) {
+      foreach ((file_exists("logs/{$instance}_heuristic_portfolio.err") ? file("logs/{$instance}_heuristic_portfolio.err", FILE_IGNORE_NEW_LINES) : [ ]) as $line) {
+         if (strncmp($line, 'best ', 5) == 0) {
+            ++$wins[substr($line, 5)];
+         }
+      }
+   }
+   echo "Portfolio wins\n";
+   foreach ($wins as $heuristic => $count) {
+      echo "   $heuristic", str_pad('', $padding - strlen($heuristic)), " $count\n";
+   }
    
    // drawing
    function execute_command($command, $input) {